@@ -0,0 +1,79 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.attls;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+import org.zowe.commons.zos.SimulatorSupport;
+
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Fetching of the partner certificate at several sizes. The sizes cover typical certificates (up to 2 kB), chains
+ * longer than the initial buffer and large certificates which need a retry with a bigger buffer.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class AttlsCertificateBenchmark {
+
+    private static final int SOCKET = 1;
+
+    @Param({"512", "1500", "4096", "16384", "65536"})
+    private int certificateLength;
+
+    @Param({"false", "true"})
+    private boolean directMemory;
+
+    @Param({"false", "true"})
+    private boolean alwaysLoadCertificate;
+
+    private AttlsContext context;
+
+    @Setup
+    public void setUp() {
+        SimulatorSupport.checkNativeLibraries();
+        context = new AttlsContext(SOCKET, alwaysLoadCertificate, directMemory);
+        SimulatorSupport.configureAttls("certificateLength", certificateLength);
+    }
+
+    @TearDown
+    public void tearDown() {
+        context.clean();
+    }
+
+    @Benchmark
+    public byte[] coldCertificate() throws Exception {
+        context.clean();
+        return context.getCertificate();
+    }
+
+    @Benchmark
+    public byte[] coldQueryAndCertificate() throws Exception {
+        context.clean();
+        context.getStatConn();
+        return context.getCertificate();
+    }
+
+}
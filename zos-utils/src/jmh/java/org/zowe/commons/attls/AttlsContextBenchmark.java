@@ -0,0 +1,107 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.attls;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+import org.openjdk.jmh.infra.Blackhole;
+import org.zowe.commons.zos.SimulatorSupport;
+
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Costs of one context: the first (cold) query with all getters, getters served from the cached query and the cleaning
+ * of context between requests. Difference between coldQuery and cleanEmpty is the cost of ioctl with the JNI
+ * transitions, difference between coldQueryAndGetters and warmGetters is the cost of the query itself.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class AttlsContextBenchmark {
+
+    private static final int SOCKET = 1;
+
+    @Param({"false", "true"})
+    private boolean directMemory;
+
+    private AttlsContext context;
+
+    @Setup
+    public void setUp() throws Exception {
+        SimulatorSupport.checkNativeLibraries();
+        context = new AttlsContext(SOCKET, false, directMemory);
+        context.getStatPolicy();
+    }
+
+    @TearDown
+    public void tearDown() {
+        context.clean();
+    }
+
+    private void allGetters(Blackhole blackhole) throws Exception {
+        blackhole.consume(context.getStatPolicy());
+        blackhole.consume(context.getStatConn());
+        blackhole.consume(context.getProtocol());
+        blackhole.consume(context.getNegotiatedCipher2());
+        blackhole.consume(context.getNegotiatedCipher4());
+        blackhole.consume(context.getSecurityType());
+        blackhole.consume(context.getUserId());
+        blackhole.consume(context.getFips140());
+        blackhole.consume(context.getFlags());
+    }
+
+    @Benchmark
+    public StatConn coldQuery() throws Exception {
+        context.clean();
+        return context.getStatConn();
+    }
+
+    @Benchmark
+    public void coldQueryAndGetters(Blackhole blackhole) throws Exception {
+        context.clean();
+        allGetters(blackhole);
+    }
+
+    @Benchmark
+    public long coldPackedStatus() throws Exception {
+        context.clean();
+        return context.getPackedStatus();
+    }
+
+    @Benchmark
+    public void warmGetters(Blackhole blackhole) throws Exception {
+        allGetters(blackhole);
+    }
+
+    @Benchmark
+    public long warmPackedStatus() throws Exception {
+        return context.getPackedStatus();
+    }
+
+    @Benchmark
+    public void cleanEmpty() {
+        context.clean();
+    }
+
+}
@@ -0,0 +1,77 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.attls;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.annotations.Warmup;
+import org.openjdk.jmh.infra.ThreadParams;
+import org.zowe.commons.zos.SimulatorSupport;
+
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Life cycle of a request in a servlet container: init of context for the socket, query and dispose. It runs in many
+ * threads to show the contention of shared state (JNI caches, enum maps, allocation of buffers).
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@Threads(8)
+public class InboundAttlsBenchmark {
+
+    private int socket;
+
+    @Setup
+    public void setUp(ThreadParams threadParams) {
+        SimulatorSupport.checkNativeLibraries();
+        socket = threadParams.getThreadIndex() + 1;
+    }
+
+    @Benchmark
+    public StatConn initQueryDispose() throws Exception {
+        InboundAttls.init(socket);
+        try {
+            return InboundAttls.getStatConn();
+        } finally {
+            InboundAttls.dispose();
+        }
+    }
+
+    @Benchmark
+    public String initQueryUserIdDispose() throws Exception {
+        InboundAttls.init(socket);
+        try {
+            InboundAttls.getStatConn();
+            return InboundAttls.getUserId();
+        } finally {
+            InboundAttls.dispose();
+        }
+    }
+
+    @Benchmark
+    public void initDispose() {
+        InboundAttls.init(socket);
+        InboundAttls.dispose();
+    }
+
+}
@@ -0,0 +1,98 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.usermap;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.annotations.Warmup;
+import org.zowe.commons.zos.SimulatorSupport;
+
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Mapping of certificates and distinguished names to user IDs, with and without cache. The set of identities is
+ * smaller than the cache, so the cached variant measures hits.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+@Threads(4)
+public class UserMapperBenchmark {
+
+    private static final int IDENTITIES = 64;
+    private static final String REGISTRY = "ldap://zowe.org";
+
+    @Param({"false", "true"})
+    private boolean cached;
+
+    @Param({"1500"})
+    private int certificateLength;
+
+    private UserMapper userMapper;
+    private byte[][] certificates;
+    private String[] distinguishedNames;
+
+    @State(Scope.Thread)
+    public static class Cursor {
+
+        private int index;
+
+        int next() {
+            index = (index + 1) % IDENTITIES;
+            return index;
+        }
+
+    }
+
+    @Setup
+    public void setUp() {
+        SimulatorSupport.checkNativeLibraries();
+        userMapper = cached ? new UserMapper(UserMapperCacheConfig.builder().build()) : new UserMapper();
+        SimulatorSupport.configureUsermap("userId", "ZWESVUSR");
+
+        Random random = new Random(0);
+        certificates = new byte[IDENTITIES][certificateLength];
+        distinguishedNames = new String[IDENTITIES];
+        for (int i = 0; i < IDENTITIES; i++) {
+            random.nextBytes(certificates[i]);
+            distinguishedNames[i] = "CN=User " + i + ",OU=Zowe,O=Open Mainframe Project";
+        }
+    }
+
+    @Benchmark
+    public CertificateResponse mapCertificate(Cursor cursor) {
+        return userMapper.getUserIDForCertificate(certificates[cursor.next()]);
+    }
+
+    @Benchmark
+    public MapperResponse mapDN(Cursor cursor) {
+        return userMapper.getUserIDForDN(distinguishedNames[cursor.next()], REGISTRY);
+    }
+
+    @Benchmark
+    public CertificateResponse[] mapCertificatesBatch() {
+        return userMapper.getUserIDsForCertificates(certificates);
+    }
+
+}
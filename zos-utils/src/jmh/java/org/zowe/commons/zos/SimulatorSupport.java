@@ -0,0 +1,40 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.zos;
+
+import lombok.experimental.UtilityClass;
+
+/**
+ * Helper for benchmarks. They call native code, so they have to run on z/OS or against the simulator (see task jmh).
+ */
+@UtilityClass
+public class SimulatorSupport {
+
+    public static void checkNativeLibraries() {
+        if (!NativeLibraryLoader.isZos() && !NativeLibraryLoader.isSimulator()) {
+            throw new IllegalStateException("Benchmarks require z/OS or native simulator, set system property "
+                + NativeLibraryLoader.SIMULATOR_PROPERTY + "=true and build libraries by task linuxbuild");
+        }
+    }
+
+    public static void configureAttls(String key, Object value) {
+        if (NativeLibraryLoader.isSimulator()) {
+            NativeSimulator.configureAttls(key, String.valueOf(value));
+        }
+    }
+
+    public static void configureUsermap(String key, Object value) {
+        if (NativeLibraryLoader.isSimulator()) {
+            NativeSimulator.configureUsermap(key, String.valueOf(value));
+        }
+    }
+
+}
@@ -0,0 +1,58 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import org.junit.jupiter.api.BeforeAll;
+import org.junit.jupiter.api.Test;
+import org.zowe.commons.zos.NativeLibraryLoader;
+import org.zowe.commons.zos.NativeSimulator;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * Fallback to TTLS_VERSION1 on a system which rejects the extended query. The probed version is kept by the process,
+ * so it is tested in its own class (task linuxTest runs each class in a new JVM).
+ */
+public class AttlsQueryVersion1SimulatorTest {
+
+    @BeforeAll
+    public static void setUpClass() {
+        assertTrue(NativeLibraryLoader.load(AttlsContext.ATTLS_LIBRARY_NAME), "Native simulator is not enabled");
+        NativeSimulator.configureAttls("queryVersion", "1");
+        NativeSimulator.configureAttls("keyShare", "001D");
+    }
+
+    @Test
+    public void testQuery_whenVersion2IsRejected() throws Exception {
+        assertEquals(0, AttlsContext.getQueryVersion());
+
+        AttlsContext context = new AttlsContext(10, false);
+        try {
+            assertEquals(StatConn.SECURE, context.getStatConn());
+            assertEquals(Protocol.TLS1_2, context.getProtocol());
+            // the key share is returned only by the extended query
+            assertNull(context.getNegotiatedKeyShare());
+            assertEquals(1, AttlsContext.getQueryVersion());
+        } finally {
+            context.clean();
+        }
+
+        // the next context does not probe the version again
+        context = new AttlsContext(11, false);
+        try {
+            context.resetSessionAndQuery(false);
+            assertEquals(StatConn.SECURE, context.getStatConn());
+            assertEquals(1, AttlsContext.getQueryVersion());
+        } finally {
+            context.clean();
+        }
+    }
+
+}
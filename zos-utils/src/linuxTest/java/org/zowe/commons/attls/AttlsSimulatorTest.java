@@ -0,0 +1,158 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeAll;
+import org.junit.jupiter.api.Test;
+import org.zowe.commons.zos.NativeLibraryLoader;
+import org.zowe.commons.zos.NativeSimulator;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * End-to-end tests of library zowe-attls against the AT-TLS simulator (see task linuxTest)
+ */
+public class AttlsSimulatorTest {
+
+    private static final int CERTIFICATE_LENGTH = 100000;
+
+    @BeforeAll
+    public static void setUpClass() {
+        assertTrue(NativeLibraryLoader.load(AttlsContext.ATTLS_LIBRARY_NAME), "Native simulator is not enabled");
+    }
+
+    @AfterEach
+    public void tearDown() {
+        NativeSimulator.configureAttls("certificateLength", "1024");
+        NativeSimulator.configureAttls("userId", "");
+        NativeSimulator.configureAttls("keyShare", "");
+    }
+
+    private void assertCertificate(byte[] certificate) {
+        assertEquals(CERTIFICATE_LENGTH, certificate.length);
+        for (int i = 0; i < certificate.length; i++) {
+            assertEquals((byte) i, certificate[i]);
+        }
+    }
+
+    @Test
+    public void testCertificate_whenBufferIsTooSmall() throws IoctlCallException {
+        NativeSimulator.configureAttls("certificateLength", String.valueOf(CERTIFICATE_LENGTH));
+
+        // the first buffer is smaller, the certificate is fetched again into a bigger one
+        AttlsContext context = new AttlsContext(10, true);
+        try {
+            assertCertificate(context.getCertificate());
+        } finally {
+            context.clean();
+        }
+    }
+
+    @Test
+    public void testCertificate_whenBufferIsTooSmallInDirectMemory() throws IoctlCallException {
+        NativeSimulator.configureAttls("certificateLength", String.valueOf(CERTIFICATE_LENGTH));
+
+        AttlsContext context = new AttlsContext(10, false, true);
+        try {
+            assertCertificate(context.getCertificate());
+        } finally {
+            context.clean();
+        }
+    }
+
+    @Test
+    public void testExtendedQuery() throws Exception {
+        NativeSimulator.configureAttls("keyShare", "001D");
+
+        AttlsContext context = new AttlsContext(10, false);
+        try {
+            assertEquals("001D", context.getNegotiatedKeyShare());
+            assertEquals(Protocol.TLS1_2, context.getProtocol());
+            assertEquals(2, AttlsContext.getQueryVersion());
+        } finally {
+            context.clean();
+        }
+    }
+
+    @Test
+    public void testUserId_isTranscodedAndInterned() throws IoctlCallException {
+        NativeSimulator.configureAttls("userId", "usr@#$9");
+
+        AttlsContext context1 = new AttlsContext(10, false);
+        AttlsContext context2 = new AttlsContext(11, false);
+        try {
+            String userId = context1.getUserId();
+            assertEquals("usr@#$9", userId);
+            // the second context gets the same instance from the intern table
+            assertSame(userId, context2.getUserId());
+        } finally {
+            context1.clean();
+            context2.clean();
+        }
+    }
+
+    @Test
+    public void testConnectionStatistics_whenContextIsCleaned() throws Exception {
+        long connections = ConnectionStatistics.snapshot().getConnections();
+        long secured = ConnectionStatistics.snapshot().getSecured();
+
+        AttlsContext context = new AttlsContext(10, false);
+        assertEquals(StatConn.SECURE, context.getStatConn());
+        ConnectionStatistics statistics = ConnectionStatistics.snapshot();
+        assertEquals(connections + 1, statistics.getConnections());
+        assertEquals(secured + 1, statistics.getSecured());
+
+        // the next query replaces values of the context, it is still counted once
+        context.resetSessionAndQuery(false);
+        assertEquals(connections + 1, ConnectionStatistics.snapshot().getConnections());
+
+        context.clean();
+        statistics = ConnectionStatistics.snapshot();
+        assertEquals(connections, statistics.getConnections());
+        assertEquals(secured, statistics.getSecured());
+    }
+
+    @Test
+    public void testConnectionStatistics_whenContextIsReleased() throws Exception {
+        long connections = ConnectionStatistics.snapshot().getConnections();
+        AttlsContextPool pool = new AttlsContextPool(1, false, false);
+
+        AttlsContext context = pool.acquire(10);
+        context.getStatConn();
+        assertEquals(connections + 1, ConnectionStatistics.snapshot().getConnections());
+        assertTrue(pool.release(context));
+        assertEquals(connections, ConnectionStatistics.snapshot().getConnections());
+    }
+
+    @Test
+    public void testConnectionStatistics_whenInboundAttlsIsDisposed() throws Exception {
+        long connections = ConnectionStatistics.snapshot().getConnections();
+
+        InboundAttls.init(10);
+        InboundAttls.getStatConn();
+        assertEquals(connections + 1, ConnectionStatistics.snapshot().getConnections());
+        InboundAttls.dispose();
+        assertEquals(connections, ConnectionStatistics.snapshot().getConnections());
+    }
+
+    @Test
+    public void testConnectionStatistics_whenRegistrationIsClosed() throws Exception {
+        long connections = ConnectionStatistics.snapshot().getConnections();
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry();
+
+        AttlsConnectionRegistry.Registration registration = registry.attach(10);
+        registration.getContext().getStatConn();
+        assertEquals(connections + 1, ConnectionStatistics.snapshot().getConnections());
+        registration.close();
+        assertEquals(connections, ConnectionStatistics.snapshot().getConnections());
+    }
+
+}
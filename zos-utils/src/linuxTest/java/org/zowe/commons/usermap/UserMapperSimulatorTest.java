@@ -0,0 +1,95 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.usermap;
+
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeAll;
+import org.junit.jupiter.api.Test;
+import org.zowe.commons.zos.NativeLibraryLoader;
+import org.zowe.commons.zos.NativeSimulator;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+/**
+ * End-to-end tests of library zowe-usermap against the user mapping simulator (see task linuxTest)
+ */
+public class UserMapperSimulatorTest {
+
+    private static final String DN = "CN=John Smith,OU=Zowe,O=Open Mainframe Project";
+    private static final String REGISTRY = "ldap://zowe.org";
+
+    /**
+     * Count of distinct user IDs which fills each stripe of the intern table several times (see userIdIntern.h)
+     */
+    private static final int INTERN_OVERFLOW = 4 * 4096;
+
+    private final UserMapper userMapper = new UserMapper();
+
+    @BeforeAll
+    public static void setUpClass() {
+        assertTrue(NativeLibraryLoader.load(UserMapper.USERMAP_LIBRARY_NAME), "Native simulator is not enabled");
+    }
+
+    @AfterEach
+    public void tearDown() {
+        NativeSimulator.configureUsermap("userId", "ZWESVUSR");
+    }
+
+    private String mapUserId(String userId) {
+        NativeSimulator.configureUsermap("userId", userId);
+        MapperResponse response = userMapper.getUserIDForDN(DN, REGISTRY);
+        assertEquals(0, response.getRc());
+        return response.getUserId();
+    }
+
+    @Test
+    public void testUserId_isInterned() {
+        String userId = mapUserId("usr@#$9");
+        assertEquals("usr@#$9", userId);
+        assertSame(userId, mapUserId("usr@#$9"));
+        assertSame(userId, userMapper.getUserIDForCertificate(new byte[] {1, 2, 3}).getUserId());
+    }
+
+    @Test
+    public void testUserId_whenTableIsFull() {
+        String userId = mapUserId("EVICTED");
+        for (int i = 0; i < INTERN_OVERFLOW; i++) {
+            assertEquals("U" + i, mapUserId("U" + i));
+        }
+
+        // the evicted ID is converted again
+        String converted = mapUserId("EVICTED");
+        assertEquals(userId, converted);
+        assertNotSame(userId, converted);
+    }
+
+    @Test
+    public void testDn_whenCharacterIsNotInCodePage() {
+        assertEquals("ZWESVUSR", userMapper.getUserIDForDN("CN=J\u00F6hn Smith,O=Zowe", REGISTRY).getUserId());
+
+        IllegalArgumentException exception = assertThrows(
+            IllegalArgumentException.class, () -> userMapper.getUserIDForDN("CN=John \u20AC,O=Zowe", REGISTRY)
+        );
+        assertEquals("Value contains a character which cannot be converted into EBCDIC", exception.getMessage());
+        assertThrows(IllegalArgumentException.class, () -> userMapper.getUserIDForDN(DN, "ldap://\u4E2D.org"));
+    }
+
+    @Test
+    public void testDn_whenValueIsTooLong() {
+        StringBuilder dn = new StringBuilder("CN=");
+        while (dn.length() <= 246) dn.append('x');
+
+        IllegalArgumentException exception = assertThrows(
+            IllegalArgumentException.class, () -> userMapper.getUserIDForDN(dn.toString(), REGISTRY)
+        );
+        assertEquals("Distinguished name is not allowed to be more than 246 characters", exception.getMessage());
+    }
+
+}
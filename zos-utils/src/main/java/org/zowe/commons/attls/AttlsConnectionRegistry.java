@@ -0,0 +1,248 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import lombok.Getter;
+import lombok.RequiredArgsConstructor;
+import lombok.Setter;
+
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.atomic.AtomicIntegerArray;
+import java.util.concurrent.atomic.AtomicReferenceArray;
+
+/**
+ * Registry of AT-TLS contexts by connection (file descriptor of socket). It is an alternative to {@link InboundAttls}
+ * for servers where one thread serves many connections and a request could move between threads (ie. event loop of
+ * Netty or WebFlux). The context could be obtained from any thread by file descriptor of the connection.
+ * <p>
+ * The registry is a lock-free hash table with open addressing (linear probing). A slot is claimed by a file descriptor
+ * with compare-and-set and the slot stays assigned to that file descriptor, only the context is attached and detached.
+ * The system reuses the lowest free file descriptors, so the set of keys is bounded by the limit of opened files of the
+ * process, and the capacity should be set above this limit (it is rounded up to a power of two).
+ * <p>
+ * The context has to be detached when the connection is closed. Method {@link #attach(int)} returns
+ * {@link Registration}, call {@link Registration#close()} in the close handler of the connection (ie.
+ * {@code channel.closeFuture().addListener(f -> registration.close())}). It detaches only its own context, so a late
+ * close of an old connection does not remove the context of a new connection with the same file descriptor. The
+ * detached context is cleaned, its native memory is released and the connection is not counted in
+ * {@link ConnectionStatistics} anymore. Contexts detached by {@link #detach(int)} have to be cleaned by the caller.
+ * <p>
+ * The registry publishes contexts safely between threads, but {@link AttlsContext} itself is not thread-safe. Requests
+ * of one connection should not use the context concurrently.
+ * <p>
+ * With prefetch (see {@link #setPrefetch(boolean)}) the query starts asynchronously when the context is attached, so the
+ * ioctl runs while the request is being parsed. Methods {@link #get(int)} and {@link #require(int)} never block, the
+ * getters of the context must not be called until the prefetch is done. Use {@link #getAsync(int)} and continue on the
+ * event loop when its future is completed.
+ */
+public class AttlsConnectionRegistry {
+
+    /**
+     * Default capacity of registry (number of distinct file descriptors)
+     */
+    public static final int DEFAULT_CAPACITY = 65536;
+
+    /**
+     * Value of not used slot in keys. Keys are stored as file descriptor + 1.
+     */
+    private static final int EMPTY = 0;
+
+    private final int mask;
+    private final AtomicIntegerArray keys;
+    private final AtomicReferenceArray<AttlsContext> contexts;
+
+    /**
+     * If this value is true, contexts created by {@link #attach(int)} fetch certificate together with other AT-TLS
+     * information.
+     */
+    private final boolean alwaysLoadCertificate;
+
+    /**
+     * If this value is true, contexts created by {@link #attach(int)} are stored in native memory
+     */
+    private final boolean directMemory;
+
+    /**
+     * If this value is true, contexts created by {@link #attach(int)} start fetching of the query immediately
+     */
+    @Setter
+    private volatile boolean prefetch;
+
+    public AttlsConnectionRegistry() {
+        this(DEFAULT_CAPACITY, false, false);
+    }
+
+    /**
+     * Create registry
+     * @param capacity maximal count of distinct file descriptors (rounded up to a power of two)
+     * @param alwaysLoadCertificate see {@link AttlsContext#AttlsContext(int, boolean, boolean)}
+     * @param directMemory see {@link AttlsContext#AttlsContext(int, boolean, boolean)}
+     */
+    public AttlsConnectionRegistry(int capacity, boolean alwaysLoadCertificate, boolean directMemory) {
+        if ((capacity <= 0) || (capacity > (1 << 30))) {
+            throw new IllegalArgumentException("Capacity of registry has to be between 1 and 2^30");
+        }
+        int size = Integer.highestOneBit(capacity);
+        if (size < capacity) size <<= 1;
+
+        this.mask = size - 1;
+        this.keys = new AtomicIntegerArray(size);
+        this.contexts = new AtomicReferenceArray<>(size);
+        this.alwaysLoadCertificate = alwaysLoadCertificate;
+        this.directMemory = directMemory;
+    }
+
+    private int hash(int fd) {
+        int h = fd * 0x9E3779B9;
+        return (h ^ (h >>> 16)) & mask;
+    }
+
+    /**
+     * Find slot of file descriptor
+     * @param fd file descriptor
+     * @param claim if true and the file descriptor has no slot, a new one is claimed
+     * @return index of slot or -1 if the file descriptor has no slot
+     * @throws IllegalStateException if a new slot is required and the registry is full
+     */
+    private int slot(int fd, boolean claim) {
+        int key = fd + 1;
+        int index = hash(fd);
+        for (int i = 0; i <= mask; i++) {
+            int current = keys.get(index);
+            if (current == key) return index;
+            if (current == EMPTY) {
+                if (!claim) return -1;
+                if (keys.compareAndSet(index, EMPTY, key)) return index;
+                // another thread claimed the slot, it could be the same file descriptor
+                if (keys.get(index) == key) return index;
+            }
+            index = (index + 1) & mask;
+        }
+        if (claim) throw new IllegalStateException("AT-TLS connection registry is full (capacity " + (mask + 1) + ")");
+        return -1;
+    }
+
+    private static void checkFd(int fd) {
+        if (fd < 0) throw new IllegalArgumentException("Invalid file descriptor: " + fd);
+    }
+
+    /**
+     * Create context for the connection and attach it
+     * @param fd file descriptor of socket
+     * @return registration to detach the context on close of the connection
+     */
+    public Registration attach(int fd) {
+        Registration registration = attach(fd, new AttlsContext(fd, alwaysLoadCertificate, directMemory));
+        if (prefetch) registration.getContext().queryAsync();
+        return registration;
+    }
+
+    /**
+     * Attach context to the connection. The previous context of the file descriptor (closed connection) is replaced.
+     * @param fd file descriptor of socket
+     * @param context AT-TLS context of the connection
+     * @return registration to detach the context on close of the connection
+     */
+    public Registration attach(int fd, AttlsContext context) {
+        checkFd(fd);
+        if (context == null) throw new IllegalArgumentException("Context cannot be null");
+        contexts.set(slot(fd, true), context);
+        return new Registration(fd, context);
+    }
+
+    /**
+     * Get context of connection. It does not wait for prefetched data (see {@link #getAsync(int)}).
+     * @param fd file descriptor of socket
+     * @return attached context or null if there is none
+     */
+    public AttlsContext get(int fd) {
+        if (fd < 0) return null;
+        int index = slot(fd, false);
+        return index < 0 ? null : contexts.get(index);
+    }
+
+    /**
+     * Get context of connection when its prefetched data are loaded (see {@link AttlsContext#whenReady()})
+     * @param fd file descriptor of socket
+     * @return future of attached context, it is completed with null if there is none
+     */
+    public CompletableFuture<AttlsContext> getAsync(int fd) {
+        AttlsContext context = get(fd);
+        return context == null ? CompletableFuture.completedFuture(null) : context.whenReady();
+    }
+
+    /**
+     * Get context of connection
+     * @param fd file descriptor of socket
+     * @return attached context
+     * @throws ContextIsNotInitializedException when no context is attached
+     */
+    public AttlsContext require(int fd) throws ContextIsNotInitializedException {
+        AttlsContext context = get(fd);
+        if (context == null) throw new ContextIsNotInitializedException();
+        return context;
+    }
+
+    /**
+     * Detach any context of the connection
+     * @param fd file descriptor of socket
+     * @return detached context or null if there was none
+     */
+    public AttlsContext detach(int fd) {
+        if (fd < 0) return null;
+        int index = slot(fd, false);
+        return index < 0 ? null : contexts.getAndSet(index, null);
+    }
+
+    /**
+     * Detach the context only if it is still attached to the connection
+     * @param fd file descriptor of socket
+     * @param context context to detach
+     * @return true if the context was detached
+     */
+    public boolean detach(int fd, AttlsContext context) {
+        if (fd < 0) return false;
+        int index = slot(fd, false);
+        return (index >= 0) && contexts.compareAndSet(index, context, null);
+    }
+
+    /**
+     * @return count of attached contexts (it iterates the whole table, use it only for monitoring)
+     */
+    public int size() {
+        int count = 0;
+        for (int i = 0; i <= mask; i++) {
+            if (contexts.get(i) != null) count++;
+        }
+        return count;
+    }
+
+    /**
+     * Attached context of one connection. Closing of registration detaches and cleans the context.
+     */
+    @Getter
+    @RequiredArgsConstructor
+    public class Registration implements AutoCloseable {
+
+        private final int fd;
+        private final AttlsContext context;
+
+        /**
+         * Detach the context and clean it (see {@link AttlsContext#clean()}), the call is idempotent. A context which
+         * is not attached anymore is not cleaned again.
+         */
+        @Override
+        public void close() {
+            if (detach(fd, context)) context.clean();
+        }
+
+    }
+
+}
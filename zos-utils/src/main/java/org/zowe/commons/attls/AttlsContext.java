@@ -9,6 +9,20 @@
  */
 package org.zowe.commons.attls;
 
+import org.zowe.commons.usermap.CertificateResponse;
+import org.zowe.commons.x509.CertificateInfo;
+import org.zowe.commons.zos.NativeLibraryLoader;
+
+import java.nio.ByteBuffer;
+import java.nio.ReadOnlyBufferException;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReferenceFieldUpdater;
+
 /**
  * This class publish all AT-TLS information about the session. As input are two parameters:
  * - id - id of filedescription to attach right session
@@ -22,8 +36,19 @@ package org.zowe.commons.attls;
  * Next calling returns only those cached value. If you want to fetch new data, you should call method
  * {@link AttlsContext#clean()}.
  * <p>
- * For fetching a certificate is needed to prepare memory before, its size is defined by
- * {@link AttlsContext#BUFFER_CERTIFICATE_LENGTH}.
+ * For fetching a certificate is needed to prepare memory before. The buffer is allocated by size classes (powers of two
+ * from {@link AttlsContext#BUFFER_CERTIFICATE_MIN_LENGTH} to {@link AttlsContext#BUFFER_CERTIFICATE_MAX_LENGTH}). The
+ * first buffer is derived from typical size of already loaded certificates. If AT-TLS reports a bigger certificate than
+ * the buffer, the buffer is enlarged and ioctl is called again.
+ * <p>
+ * By default the request block and the certificate buffer are byte arrays on Java heap. They have to be pinned (and on
+ * a copying JVM copied) in each native call. With parameter directMemory both of them are allocated in native memory
+ * owned by direct {@link ByteBuffer}. Their addresses are stable, and repeated calls do not touch any Java heap copy.
+ * <p>
+ * Methods {@link #queryAsync()} and {@link #getCertificateAsync()} call ioctl on a small dedicated executor, so an
+ * event loop (or a virtual thread) is not blocked by the native call. Concurrent asynchronous requests of the same kind
+ * share the same ioctl, and all asynchronous calls of one context run one after another, because they use the same
+ * request block and certificate buffer.
  */
 public class AttlsContext {
 
@@ -32,14 +57,38 @@ public class AttlsContext {
      */
     public static final String ATTLS_LIBRARY_NAME = "zowe-attls";
     /**
-     * Size of buffer to fetch certificate
+     * Minimal size of buffer to fetch certificate (the smallest size class)
+     */
+    private static final int BUFFER_CERTIFICATE_MIN_LENGTH = 2048;
+    /**
+     * Maximal size of buffer to fetch certificate (the biggest size class)
+     */
+    private static final int BUFFER_CERTIFICATE_MAX_LENGTH = 1048576;
+    /**
+     * System property with number of threads of executor for asynchronous calls (default is the number of processors,
+     * at most 4)
+     */
+    public static final String ASYNC_THREADS_PROPERTY = "org.zowe.commons.attls.async.threads";
+    /**
+     * System property with default value of {@link #setTolerateUnknownValues(boolean)}
+     */
+    public static final String TOLERATE_UNKNOWN_VALUES_PROPERTY = "org.zowe.commons.attls.tolerateUnknownValues";
+
+    private static final AtomicReferenceFieldUpdater<AttlsContext, CompletableFuture> QUERY_FUTURE =
+        AtomicReferenceFieldUpdater.newUpdater(AttlsContext.class, CompletableFuture.class, "queryFuture");
+    private static final AtomicReferenceFieldUpdater<AttlsContext, CompletableFuture> CERTIFICATE_FUTURE =
+        AtomicReferenceFieldUpdater.newUpdater(AttlsContext.class, CompletableFuture.class, "certificateFuture");
+    private static final AtomicReferenceFieldUpdater<AttlsContext, CompletableFuture> LAST_FUTURE =
+        AtomicReferenceFieldUpdater.newUpdater(AttlsContext.class, CompletableFuture.class, "lastFuture");
+
+    /**
+     * Control flag of getters of enumerations for values unknown to this library (see
+     * {@link #setTolerateUnknownValues(boolean)}). Native code reads it only when a value is not known.
      */
-    private static final int BUFFER_CERTIFICATE_LENGTH = 10240;
+    private static volatile boolean tolerateUnknownValues = Boolean.getBoolean(TOLERATE_UNKNOWN_VALUES_PROPERTY);
 
     static {
-        if ("z/os".equalsIgnoreCase(System.getProperty("os.name"))) {
-            System.loadLibrary(ATTLS_LIBRARY_NAME);
-        }
+        NativeLibraryLoader.load(ATTLS_LIBRARY_NAME);
     }
 
     /**
@@ -47,6 +96,16 @@ public class AttlsContext {
      */
     private boolean alwaysLoadCertificate;
 
+    /**
+     * Control flag to identify if request and certificate are stored in native memory (direct buffers) or on heap
+     */
+    private boolean directMemory;
+
+    /**
+     * Control flag to identify if {@link #getCertificate()} stores the copy of certificate in {@link #certificateCache}
+     */
+    private boolean cacheCertificate = true;
+
     /**
      * FileDescriptior of socket
      */
@@ -59,6 +118,14 @@ public class AttlsContext {
      * Buffer for storing certificate
      */
     private byte[] bufferCertificate;
+    /**
+     * Request memory data in native memory (used instead of ioctl if directMemory is set)
+     */
+    private ByteBuffer ioctlDirect;
+    /**
+     * Buffer for storing certificate in native memory (used instead of bufferCertificate if directMemory is set)
+     */
+    private ByteBuffer bufferCertificateDirect;
 
     /**
      * true if query data are loaded
@@ -68,6 +135,10 @@ public class AttlsContext {
      * true if certificate is loaded
      */
     private boolean certificateLoaded;
+    /**
+     * key of values counted in {@link ConnectionStatistics} by the last query, 0 if the context is not counted
+     */
+    private long connectionStatsKey;
 
     /**
      * cache for loaded values from ioctl
@@ -80,8 +151,21 @@ public class AttlsContext {
     private String userIdCache;
     private Fips140 fips140Cache;
     private String negotiatedCipher4Cache;
+    private CipherSuite cipherSuiteCache;
     private String negotiatedKeyShareCache;
     private byte[] certificateCache;
+    private CertificateInfo certificateInfoCache;
+
+    /**
+     * pending or finished asynchronous calls, they are cleaned together with cached values (see {@link #clean()})
+     */
+    private volatile CompletableFuture<AttlsContext> queryFuture;
+    private volatile CompletableFuture<byte[]> certificateFuture;
+
+    /**
+     * the last submitted asynchronous call, the next one starts when it is done (calls of a context never overlap)
+     */
+    private volatile CompletableFuture<?> lastFuture;
 
     /**
      * Create context of socket identified by FileDescriptor id ({@link java.io.FileDescriptor},
@@ -92,14 +176,94 @@ public class AttlsContext {
      *                              loaded in first call of {@link AttlsContext#getCertificate}
      */
     public AttlsContext(int id, boolean alwaysLoadCertificate) {
+        this(id, alwaysLoadCertificate, false);
+    }
+
+    /**
+     * Create context of socket identified by FileDescriptor id ({@link java.io.FileDescriptor},
+     * {@link sun.nio.ch.IOUtil#fdVal(java.io.FileDescriptor)}).
+     *
+     * @param id                    filedescriptor of socket
+     * @param alwaysLoadCertificate if set true, first query call will fetch also a certificate, otherwise it will be
+     *                              loaded in first call of {@link AttlsContext#getCertificate}
+     * @param directMemory          if set true, request and certificate are stored in native memory (direct buffers)
+     *                              instead of byte arrays on Java heap
+     */
+    public AttlsContext(int id, boolean alwaysLoadCertificate, boolean directMemory) {
         this.id = id;
         this.alwaysLoadCertificate = alwaysLoadCertificate;
+        this.directMemory = directMemory;
+    }
+
+    /**
+     * Clean all cached value. Next call will fetch new data via ioctl. Direct buffers (if used) are zeroed and kept for
+     * next calls. A pending asynchronous call is awaited first, because it uses the buffers.
+     */
+    public void clean() {
+        awaitAsync();
+        cleanNative();
+    }
+
+    private native void cleanNative();
+
+    /**
+     * Prepare the context for another socket (see {@link AttlsContextPool}). All cached values are cleaned as by
+     * {@link #clean()}, but the request and the certificate buffer are zeroed and kept, so the next query does not
+     * allocate them again. Settings alwaysLoadCertificate and directMemory are not changed.
+     *
+     * @param id filedescriptor of the new socket
+     */
+    public void reset(int id) {
+        awaitAsync();
+        resetNative(id);
+    }
+
+    private native void resetNative(int id);
+
+    /**
+     * Assigns the socket to a context which was already reset (see {@link AttlsContextPool#acquire(int)})
+     */
+    void setId(int id) {
+        this.id = id;
+    }
+
+    /**
+     * Set if {@link #getCertificate()} keeps the copy of certificate. By default the first call creates the array and
+     * next calls return the same one. Without the cache each call creates a new array and the context holds only the
+     * certificate buffer, what halves the memory of the certificate per connection. It is suitable together with
+     * {@link #getCertificate(byte[], int)} and {@link #getCertificate(ByteBuffer)}, which never use the cache. The
+     * setting is not changed by {@link #clean()} or {@link #reset(int)}.
+     *
+     * @param cacheCertificate false to create a new array in each call of {@link #getCertificate()}
+     */
+    public void setCacheCertificate(boolean cacheCertificate) {
+        this.cacheCertificate = cacheCertificate;
     }
 
     /**
-     * Clean all cached value. Next call will fetch new data via ioctl.
+     * @return true if {@link #getCertificate()} keeps the copy of certificate
      */
-    public native void clean();
+    public boolean isCacheCertificate() {
+        return cacheCertificate;
+    }
+
+    /**
+     * Set behaviour of getters of enumerations (ie. {@link #getProtocol()}) when AT-TLS returns a value which is not
+     * known by this library. By default they throw {@link UnknownEnumValueException}. In tolerant mode they return
+     * constant {@code UNRECOGNIZED} of the enumeration, so a newer AT-TLS does not break the application.
+     *
+     * @param tolerateUnknownValues true to return {@code UNRECOGNIZED} instead of exception
+     */
+    public static void setTolerateUnknownValues(boolean tolerateUnknownValues) {
+        AttlsContext.tolerateUnknownValues = tolerateUnknownValues;
+    }
+
+    /**
+     * @return true if getters of enumerations return {@code UNRECOGNIZED} instead of exception
+     */
+    public static boolean isTolerateUnknownValues() {
+        return tolerateUnknownValues;
+    }
 
     /**
      * Indicates the policy status for the connection at the time of policy lookup always returned (except in error cases)
@@ -184,16 +348,133 @@ public class AttlsContext {
      */
     public native String getNegotiatedCipher4() throws IoctlCallException;
 
+    /**
+     * Indicates the negotiated key share group of TLSv1.3 (4 hexadecimal characters of IANA code, ie. "001D" for
+     * x25519). It is returned by the extended query (see {@link #getQueryVersion()}) in the same call as other values.
+     *
+     * @return negotiated key share group, or null if it is not available (older z/OS or the connection is not TLSv1.3)
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public native String getNegotiatedKeyShare() throws IoctlCallException;
+
+    /**
+     * Returns the negotiated cipher suite. The value is shared, no object is created per connection.
+     *
+     * @return negotiated cipher suite, or null if the cipher is not known (see {@link #getNegotiatedCipher4()})
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public native CipherSuite getCipherSuite() throws IoctlCallException;
+
+    /**
+     * Returns all primitive values of the query (policy, connection status, protocol, security type, FIPS 140, flags
+     * and length of partner user ID) packed into one long. It is fetched by one native call and no Java object is
+     * created. To decode the value use {@link PackedStatus}.
+     *
+     * @return packed status of the connection
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public native long getPackedStatus() throws IoctlCallException;
+
+    /**
+     * Query of the connection which never throws an exception about ioctl. It is intended for a high-rate probing (ie.
+     * ports without AT-TLS policy), where creating of exceptions with stack traces would be too expensive.
+     *
+     * On success it stores the packed status (see {@link PackedStatus}) into status[0] and returns 0. If ioctl fails,
+     * it returns errno (or -1 if it is not available) and stores errno2 into status[1]. The array could be shorter or
+     * null, then the values are not stored. The result of a successful query is cached as with the other getters.
+     *
+     * @param status array for the packed status and errno2 (it could be null)
+     * @return 0 on success, otherwise errno of ioctl
+     */
+    public native int tryQuery(long[] status);
+
 
     /**
      * Returns partner certificate - returned when available. Maximum length of certificate is determinated by
-     * {@link AttlsContext#BUFFER_CERTIFICATE_LENGTH}
+     * {@link AttlsContext#BUFFER_CERTIFICATE_MAX_LENGTH}
      *
      * @return partner certificate
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public native byte[] getCertificate() throws IoctlCallException;
 
+    /**
+     * Copies partner certificate into the caller's array, so one array could be reused for many connections. The
+     * certificate is copied directly from the certificate buffer and it is not cached (see
+     * {@link #setCacheCertificate(boolean)}).
+     *
+     * @param dst target array
+     * @param off offset in the target array
+     * @return length of certificate (0 if there is none), if it is bigger than {@code dst.length - off} nothing is
+     * copied
+     * @throws IoctlCallException unexpected error in call of ioctl
+     * @throws IndexOutOfBoundsException offset is out of the array
+     */
+    public int getCertificate(byte[] dst, int off) throws IoctlCallException {
+        if ((off < 0) || (off > dst.length)) {
+            throw new IndexOutOfBoundsException("Offset " + off + " is out of array with length " + dst.length);
+        }
+        return copyCertificate(dst, off, dst.length - off);
+    }
+
+    /**
+     * Copies partner certificate into the caller's buffer at its position. If the certificate fits into the remaining
+     * space, the position is moved after it. A direct buffer is written natively, a heap buffer through its backing
+     * array. The certificate is not cached (see {@link #setCacheCertificate(boolean)}).
+     *
+     * @param dst target buffer
+     * @return length of certificate (0 if there is none), if it is bigger than {@code dst.remaining()} nothing is
+     * copied and the position is not changed
+     * @throws IoctlCallException unexpected error in call of ioctl
+     * @throws ReadOnlyBufferException the buffer is read-only
+     */
+    public int getCertificate(ByteBuffer dst) throws IoctlCallException {
+        if (dst.isReadOnly()) throw new ReadOnlyBufferException();
+
+        int position = dst.position();
+        int remaining = dst.remaining();
+        int length;
+        if (dst.isDirect()) {
+            length = copyCertificateDirect(dst, position, remaining);
+        } else {
+            length = copyCertificate(dst.array(), dst.arrayOffset() + position, remaining);
+        }
+        if (length <= remaining) dst.position(position + length);
+        return length;
+    }
+
+    /**
+     * Copies partner certificate into the array if it fits into len bytes from off
+     */
+    native int copyCertificate(byte[] dst, int off, int len) throws IoctlCallException;
+
+    /**
+     * Copies partner certificate into the direct buffer (absolute offset) if it fits into len bytes from off
+     */
+    native int copyCertificateDirect(ByteBuffer dst, int off, int len) throws IoctlCallException;
+
+    /**
+     * Returns serial number, issuer, subject, validity and SHA-256 fingerprint of partner certificate. The fields are
+     * read natively from the certificate buffer, neither copy of the certificate nor
+     * {@link java.security.cert.X509Certificate} is created.
+     *
+     * @return basic fields of partner certificate, or null if there is no partner certificate
+     * @throws IoctlCallException unexpected error in call of ioctl
+     * @throws IllegalArgumentException partner certificate is not valid
+     */
+    public native CertificateInfo getCertificateInfo() throws IoctlCallException;
+
+    /**
+     * Maps partner certificate to RACF user ID in one native call. If AT-TLS has already mapped the user ID (see
+     * {@link #getUserId()}), it is returned without calling SAF. Otherwise the certificate buffer is passed directly to
+     * the SAF service (__certificate), the certificate is not copied on Java heap. The result has the same meaning as
+     * in {@link org.zowe.commons.usermap.UserMapper#getUserIDForCertificate(byte[])}.
+     *
+     * @return mapped user ID and status of the mapping
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public native CertificateResponse mapCertificateToUserId() throws IoctlCallException;
+
     /**
      * Initialize the SSL connection
      *
@@ -215,6 +496,49 @@ public class AttlsContext {
      */
     public native void resetCipher() throws IoctlCallException;
 
+    /**
+     * Initialize the SSL connection and query its state in the same ioctl call. Cached values are cleaned (as by
+     * {@link #clean()}) and filled from the response, so the next getters do not call ioctl again.
+     * A pending asynchronous call is awaited first, because it uses the same buffers.
+     *
+     * @param certificate if set true, the partner certificate is fetched too (as with alwaysLoadCertificate)
+     * @throws IoctlCallException cannot initialize (ie. not in controlled mode, missing configuration etc.)
+     */
+    public void initConnectionAndQuery(boolean certificate) throws IoctlCallException {
+        awaitAsync();
+        initConnectionAndQueryNative(certificate);
+    }
+
+    private native void initConnectionAndQueryNative(boolean certificate) throws IoctlCallException;
+
+    /**
+     * Reset the Session and query the state of connection in the same ioctl call (see
+     * {@link #initConnectionAndQuery(boolean)})
+     *
+     * @param certificate if set true, the partner certificate is fetched too
+     * @throws IoctlCallException cannot reset session (ie. not in controlled mode, missing configuration etc.)
+     */
+    public void resetSessionAndQuery(boolean certificate) throws IoctlCallException {
+        awaitAsync();
+        resetSessionAndQueryNative(certificate);
+    }
+
+    private native void resetSessionAndQueryNative(boolean certificate) throws IoctlCallException;
+
+    /**
+     * Reset the Cipher and query the state of connection in the same ioctl call (see
+     * {@link #initConnectionAndQuery(boolean)})
+     *
+     * @param certificate if set true, the partner certificate is fetched too
+     * @throws IoctlCallException cannot reset cipher (ie. not in controlled mode, missing configuration etc.)
+     */
+    public void resetCipherAndQuery(boolean certificate) throws IoctlCallException {
+        awaitAsync();
+        resetCipherAndQueryNative(certificate);
+    }
+
+    private native void resetCipherAndQueryNative(boolean certificate) throws IoctlCallException;
+
     /**
      * Stop the SSL connection
      *
@@ -229,5 +553,188 @@ public class AttlsContext {
      */
     public native void allowHandShakeTimeout() throws IoctlCallException;
 
+    /**
+     * Returns version of query request used by the library. The first query probes version 2 (with extended fields)
+     * and falls back to version 1 if the TCP/IP stack does not support it.
+     *
+     * @return 2 or 1, or 0 if no query succeeded yet
+     */
+    public static native int getQueryVersion();
+
+    /**
+     * Copies counters and latency histograms of ioctl calls (see {@link org.zowe.commons.zos.NativeMetrics}).
+     *
+     * @param target array for the values, it could be null to get the required length
+     * @return number of values, if it is bigger than length of target nothing is copied
+     */
+    public static native int readNativeMetrics(long[] target);
+
+    /**
+     * Copies counts of queried connections by policy status, connection status, protocol, cipher and FIPS 140 (see
+     * {@link ConnectionStatistics#snapshot()}).
+     *
+     * @param target array for the values, it could be null to get the required length
+     * @return number of values, if it is bigger than length of target nothing is copied
+     */
+    public static native int readConnectionStatistics(long[] target);
+
+    /**
+     * Fetches the query data on the default executor (see {@link #ASYNC_THREADS_PROPERTY}). The future is completed
+     * with this context, its getters then return values without any ioctl. If alwaysLoadCertificate is set, the
+     * certificate is fetched too. Concurrent calls return the same future until {@link #clean()} is called, a failed
+     * call is not cached.
+     * <p>
+     * The future is completed on a thread of the executor, use the asynchronous methods of the future (ie.
+     * {@code thenAcceptAsync(action, eventLoop)}) to continue on the event loop.
+     *
+     * @return future of this context with loaded query data, it completes exceptionally with {@link IoctlCallException}
+     */
+    public CompletableFuture<AttlsContext> queryAsync() {
+        return queryAsync(AsyncExecutor.INSTANCE);
+    }
+
+    /**
+     * Fetches the query data on the given executor, see {@link #queryAsync()}
+     *
+     * @param executor executor to call ioctl
+     * @return future of this context with loaded query data
+     */
+    public CompletableFuture<AttlsContext> queryAsync(Executor executor) {
+        return submit(QUERY_FUTURE, executor, () -> {
+            getPackedStatus();
+            return this;
+        });
+    }
+
+    /**
+     * Fetches the partner certificate on the default executor (see {@link #ASYNC_THREADS_PROPERTY}). Concurrent calls
+     * return the same future until {@link #clean()} is called, a failed call is not cached.
+     *
+     * @return future of partner certificate, it completes exceptionally with {@link IoctlCallException}
+     */
+    public CompletableFuture<byte[]> getCertificateAsync() {
+        return getCertificateAsync(AsyncExecutor.INSTANCE);
+    }
+
+    /**
+     * Fetches the partner certificate on the given executor, see {@link #getCertificateAsync()}
+     *
+     * @param executor executor to call ioctl
+     * @return future of partner certificate
+     */
+    public CompletableFuture<byte[]> getCertificateAsync(Executor executor) {
+        return submit(CERTIFICATE_FUTURE, executor, this::getCertificate);
+    }
+
+    /**
+     * Waits until all pending asynchronous calls are finished. Getters must not run concurrently with an asynchronous
+     * call, so a caller which does not compose on the futures (ie. a blocking servlet thread) should call this method
+     * first, others should use {@link #whenReady()}. It blocks the thread, do not call it on an event loop. Failures
+     * are ignored here, the next getter calls ioctl again and throws the exception.
+     */
+    public void awaitAsync() {
+        CompletableFuture<?> future = lastFuture;
+        if ((future == null) || future.isDone()) return;
+        try {
+            future.join();
+        } catch (RuntimeException e) {
+            // the failure is reported by the next getter
+        }
+    }
+
+    /**
+     * Returns future which is completed with this context when all pending asynchronous calls are finished (successfully
+     * or not). It does not block, use it to continue on an event loop after the prefetch (ie.
+     * {@code context.whenReady().thenAcceptAsync(action, eventLoop)}).
+     *
+     * @return future of this context
+     */
+    public CompletableFuture<AttlsContext> whenReady() {
+        CompletableFuture<?> future = lastFuture;
+        if ((future == null) || future.isDone()) return CompletableFuture.completedFuture(this);
+        return future.handle((result, failure) -> this);
+    }
+
+    /**
+     * Returns the pending (or finished) call or submits a new one. Only the thread which sets the future submits the
+     * task, so concurrent requests are coalesced into one ioctl. The task is chained after the last submitted call of
+     * this context (see {@link #lastFuture}), so two calls never use the buffers at the same time.
+     */
+    @SuppressWarnings("unchecked")
+    private <T> CompletableFuture<T> submit(
+        AtomicReferenceFieldUpdater<AttlsContext, CompletableFuture> updater, Executor executor, IoctlCall<T> call
+    ) {
+        CompletableFuture<T> future = updater.get(this);
+        if (future != null) return future;
+
+        CompletableFuture<T> created = new CompletableFuture<>();
+        while (!updater.compareAndSet(this, null, created)) {
+            future = updater.get(this);
+            if (future != null) return future;
+        }
+
+        Runnable task = () -> {
+            try {
+                created.complete(call.call());
+            } catch (Throwable t) {
+                // failed call is not cached, next call could try it again
+                updater.compareAndSet(this, created, null);
+                created.completeExceptionally(t);
+            }
+        };
+        CompletableFuture<?> previous = LAST_FUTURE.getAndSet(this, created);
+        if ((previous == null) || previous.isDone()) {
+            execute(updater, executor, created, task);
+        } else {
+            previous.whenComplete((result, failure) -> execute(updater, executor, created, task));
+        }
+        return created;
+    }
+
+    private <T> void execute(
+        AtomicReferenceFieldUpdater<AttlsContext, CompletableFuture> updater, Executor executor,
+        CompletableFuture<T> created, Runnable task
+    ) {
+        try {
+            executor.execute(task);
+        } catch (RuntimeException e) {
+            // rejected, next call could try it again
+            updater.compareAndSet(this, created, null);
+            created.completeExceptionally(e);
+        }
+    }
+
+    @FunctionalInterface
+    private interface IoctlCall<T> {
+
+        T call() throws IoctlCallException;
+
+    }
+
+    /**
+     * Lazy holder of the default executor. Threads are daemons, the executor does not block shutdown of JVM.
+     */
+    private static class AsyncExecutor {
+
+        static final ExecutorService INSTANCE = Executors.newFixedThreadPool(threads(), new ThreadFactory() {
+
+            private final AtomicInteger counter = new AtomicInteger();
+
+            @Override
+            public Thread newThread(Runnable runnable) {
+                Thread thread = new Thread(runnable, "zowe-attls-" + counter.incrementAndGet());
+                thread.setDaemon(true);
+                return thread;
+            }
+
+        });
+
+        private static int threads() {
+            int threads = Integer.getInteger(ASYNC_THREADS_PROPERTY, Math.min(4, Runtime.getRuntime().availableProcessors()));
+            return Math.max(1, threads);
+        }
+
+    }
+
 
 }
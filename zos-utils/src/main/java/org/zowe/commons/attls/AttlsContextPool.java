@@ -0,0 +1,107 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import lombok.Getter;
+
+import java.util.concurrent.atomic.AtomicReferenceArray;
+
+/**
+ * Bounded pool of AT-TLS contexts. A released context is reset by {@link AttlsContext#reset(int)}: data of the
+ * previous connection (ie. partner certificate and user ID) are zeroed and the connection is not counted in
+ * {@link ConnectionStatistics} anymore, but the request and certificate buffer are kept. {@link #acquire(int)} only
+ * assigns the new socket. In a steady state no context and no buffer is allocated per connection.
+ * <p>
+ * The pool is lock-free and it does not allocate. Contexts are stored in slots, each thread starts to search for a
+ * context (or for a free slot) at a different slot to avoid contention. If the pool is empty, a new context is created.
+ * If it is full, the released context is dropped.
+ * <p>
+ * A context could be released only if nobody uses it anymore (ie. at the end of request, see
+ * {@link InboundAttls#dispose()}). All contexts of the pool have the same settings.
+ */
+public class AttlsContextPool {
+
+    private final AtomicReferenceArray<AttlsContext> slots;
+
+    @Getter
+    private final boolean alwaysLoadCertificate;
+
+    @Getter
+    private final boolean directMemory;
+
+    /**
+     * Create pool
+     * @param capacity maximal count of idle contexts
+     * @param alwaysLoadCertificate see {@link AttlsContext#AttlsContext(int, boolean, boolean)}
+     * @param directMemory see {@link AttlsContext#AttlsContext(int, boolean, boolean)}
+     */
+    public AttlsContextPool(int capacity, boolean alwaysLoadCertificate, boolean directMemory) {
+        if (capacity <= 0) throw new IllegalArgumentException("Capacity of pool has to be positive");
+        this.slots = new AtomicReferenceArray<>(capacity);
+        this.alwaysLoadCertificate = alwaysLoadCertificate;
+        this.directMemory = directMemory;
+    }
+
+    private int start() {
+        return (int) (Thread.currentThread().getId() % slots.length());
+    }
+
+    /**
+     * Returns context for the socket, an idle one if it is available, otherwise a new one
+     * @param id filedescriptor of socket
+     * @return context of the socket
+     */
+    public AttlsContext acquire(int id) {
+        int length = slots.length();
+        int index = start();
+        for (int i = 0; i < length; i++) {
+            if (slots.get(index) != null) {
+                AttlsContext context = slots.getAndSet(index, null);
+                if (context != null) {
+                    context.setId(id);
+                    return context;
+                }
+            }
+            if (++index == length) index = 0;
+        }
+        return new AttlsContext(id, alwaysLoadCertificate, directMemory);
+    }
+
+    /**
+     * Resets the context and returns it into the pool. Pending asynchronous calls are awaited first. The context is
+     * reset even if the pool is full and it is dropped.
+     * @param context context which is not used anymore
+     * @return true if the context was stored, false if the pool is full
+     */
+    public boolean release(AttlsContext context) {
+        if (context == null) return false;
+        context.reset(-1);
+
+        int length = slots.length();
+        int index = start();
+        for (int i = 0; i < length; i++) {
+            if ((slots.get(index) == null) && slots.compareAndSet(index, null, context)) return true;
+            if (++index == length) index = 0;
+        }
+        return false;
+    }
+
+    /**
+     * @return count of idle contexts (it iterates the whole pool, use it only for monitoring)
+     */
+    public int size() {
+        int count = 0;
+        for (int i = 0; i < slots.length(); i++) {
+            if (slots.get(i) != null) count++;
+        }
+        return count;
+    }
+
+}
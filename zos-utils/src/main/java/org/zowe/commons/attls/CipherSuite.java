@@ -0,0 +1,127 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import lombok.AllArgsConstructor;
+import lombok.Getter;
+
+import java.util.HashMap;
+import java.util.Locale;
+import java.util.Map;
+
+/**
+ * Cipher suites which could be negotiated by AT-TLS. The name of each value is the IANA name of the suite. AT-TLS
+ * identifies the suite by a 4-character code (hexadecimal value of IANA code) and for suites defined before TLS 1.3
+ * without elliptic curves also by a 2-character code.
+ *
+ * The native library reads this enumeration on loading and returns the shared values (and their codes) without
+ * creating any object per connection.
+ */
+@AllArgsConstructor
+public enum CipherSuite {
+
+        TLS_RSA_WITH_NULL_MD5("0001", "01", KeyExchange.RSA, 0),
+        TLS_RSA_WITH_NULL_SHA("0002", "02", KeyExchange.RSA, 0),
+        TLS_RSA_WITH_RC4_128_MD5("0004", "04", KeyExchange.RSA, 128),
+        TLS_RSA_WITH_RC4_128_SHA("0005", "05", KeyExchange.RSA, 128),
+        TLS_RSA_WITH_3DES_EDE_CBC_SHA("000A", "0A", KeyExchange.RSA, 112),
+        TLS_DHE_RSA_WITH_3DES_EDE_CBC_SHA("0016", "16", KeyExchange.DHE_RSA, 112),
+        TLS_RSA_WITH_AES_128_CBC_SHA("002F", "2F", KeyExchange.RSA, 128),
+        TLS_DHE_RSA_WITH_AES_128_CBC_SHA("0033", "33", KeyExchange.DHE_RSA, 128),
+        TLS_RSA_WITH_AES_256_CBC_SHA("0035", "35", KeyExchange.RSA, 256),
+        TLS_DHE_RSA_WITH_AES_256_CBC_SHA("0039", "39", KeyExchange.DHE_RSA, 256),
+        TLS_RSA_WITH_AES_128_CBC_SHA256("003C", "3C", KeyExchange.RSA, 128),
+        TLS_RSA_WITH_AES_256_CBC_SHA256("003D", "3D", KeyExchange.RSA, 256),
+        TLS_DHE_RSA_WITH_AES_128_CBC_SHA256("0067", "67", KeyExchange.DHE_RSA, 128),
+        TLS_DHE_RSA_WITH_AES_256_CBC_SHA256("006B", "6B", KeyExchange.DHE_RSA, 256),
+        TLS_RSA_WITH_AES_128_GCM_SHA256("009C", "9C", KeyExchange.RSA, 128),
+        TLS_RSA_WITH_AES_256_GCM_SHA384("009D", "9D", KeyExchange.RSA, 256),
+        TLS_DHE_RSA_WITH_AES_128_GCM_SHA256("009E", "9E", KeyExchange.DHE_RSA, 128),
+        TLS_DHE_RSA_WITH_AES_256_GCM_SHA384("009F", "9F", KeyExchange.DHE_RSA, 256),
+        TLS_AES_128_GCM_SHA256("1301", null, KeyExchange.TLS13, 128),
+        TLS_AES_256_GCM_SHA384("1302", null, KeyExchange.TLS13, 256),
+        TLS_CHACHA20_POLY1305_SHA256("1303", null, KeyExchange.TLS13, 256),
+        TLS_ECDHE_ECDSA_WITH_3DES_EDE_CBC_SHA("C008", null, KeyExchange.ECDHE_ECDSA, 112),
+        TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA("C009", null, KeyExchange.ECDHE_ECDSA, 128),
+        TLS_ECDHE_ECDSA_WITH_AES_256_CBC_SHA("C00A", null, KeyExchange.ECDHE_ECDSA, 256),
+        TLS_ECDHE_RSA_WITH_3DES_EDE_CBC_SHA("C012", null, KeyExchange.ECDHE_RSA, 112),
+        TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA("C013", null, KeyExchange.ECDHE_RSA, 128),
+        TLS_ECDHE_RSA_WITH_AES_256_CBC_SHA("C014", null, KeyExchange.ECDHE_RSA, 256),
+        TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256("C023", null, KeyExchange.ECDHE_ECDSA, 128),
+        TLS_ECDHE_ECDSA_WITH_AES_256_CBC_SHA384("C024", null, KeyExchange.ECDHE_ECDSA, 256),
+        TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA256("C027", null, KeyExchange.ECDHE_RSA, 128),
+        TLS_ECDHE_RSA_WITH_AES_256_CBC_SHA384("C028", null, KeyExchange.ECDHE_RSA, 256),
+        TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256("C02B", null, KeyExchange.ECDHE_ECDSA, 128),
+        TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384("C02C", null, KeyExchange.ECDHE_ECDSA, 256),
+        TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256("C02F", null, KeyExchange.ECDHE_RSA, 128),
+        TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384("C030", null, KeyExchange.ECDHE_RSA, 256)
+
+    ;
+
+    /**
+     * Method of key exchange
+     */
+    public enum KeyExchange {
+
+        RSA,
+        DHE_RSA,
+        ECDHE_RSA,
+        ECDHE_ECDSA,
+        /**
+         * TLS 1.3 suites do not define the key exchange (see negotiated key share)
+         */
+        TLS13
+
+    }
+
+    private static final Map<String, CipherSuite> BY_CODE = new HashMap<>();
+
+    static {
+        for (CipherSuite cipherSuite : values()) {
+            BY_CODE.put(cipherSuite.code4, cipherSuite);
+            if (cipherSuite.code2 != null) BY_CODE.put(cipherSuite.code2, cipherSuite);
+        }
+    }
+
+    /**
+     * 4-character code of AT-TLS (hexadecimal IANA code)
+     */
+    @Getter
+    private final String code4;
+
+    /**
+     * 2-character code of AT-TLS, null if the suite has only 4-character code
+     */
+    @Getter
+    private final String code2;
+
+    @Getter
+    private final KeyExchange keyExchange;
+
+    /**
+     * Strength of the bulk cipher in bits (effective, ie. 112 for 3DES), 0 for suites without encryption
+     */
+    @Getter
+    private final int strength;
+
+    public String getIanaName() {
+        return name();
+    }
+
+    /**
+     * @param code 2-character or 4-character code of AT-TLS
+     * @return cipher suite or null if the code is unknown
+     */
+    public static CipherSuite valueOfCode(String code) {
+        if (code == null) return null;
+        return BY_CODE.get(code.toUpperCase(Locale.ROOT));
+    }
+
+}
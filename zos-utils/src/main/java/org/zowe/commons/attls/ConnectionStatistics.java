@@ -0,0 +1,153 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import lombok.Value;
+
+import java.util.Collections;
+import java.util.EnumMap;
+import java.util.Locale;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.function.IntFunction;
+
+/**
+ * Snapshot of the population of queried connections: counts of connections by policy status, connection status,
+ * protocol, cipher and FIPS 140 level. The native library updates the gauges by successful query ioctl (see
+ * connectionStats.h), so they cost neither an extra ioctl nor a Java object per connection. Each context is counted
+ * once with values of its last query, and it is removed by {@link AttlsContext#clean()} or
+ * {@link AttlsContext#reset(int)}. {@link InboundAttls#dispose()}, {@link AttlsContextPool#release(AttlsContext)} and
+ * {@link AttlsConnectionRegistry.Registration#close()} do it, a context which is dropped without clean stays counted.
+ * <p>
+ * Values unknown to this library are counted as {@code UNRECOGNIZED}. Ciphers are keyed by their 4-character code
+ * (see {@link CipherSuite#valueOfCode(String)}), counts of ciphers which did not fit into the native table are summed
+ * in ciphersOverflow.
+ */
+@Value
+public class ConnectionStatistics {
+
+    private static final int VERSION = 2;
+    private static final int HEADER_LENGTH = 6;
+    private static final int PROTOCOL_MODS = 8;
+
+    long connections;
+    Map<StatPolicy, Long> statPolicies;
+    Map<StatConn, Long> statConns;
+    Map<Fips140, Long> fips140s;
+    Map<Protocol, Long> protocols;
+    Map<String, Long> ciphers;
+    long ciphersOverflow;
+
+    /**
+     * @return current values of counters of library zowe-attls
+     */
+    public static ConnectionStatistics snapshot() {
+        long[] values = new long[AttlsContext.readConnectionStatistics(null)];
+        int length;
+        while ((length = AttlsContext.readConnectionStatistics(values)) > values.length) {
+            values = new long[length];
+        }
+        return parse(values);
+    }
+
+    /**
+     * Decodes values copied by the native library (see stats_copy in connectionStats.c)
+     *
+     * @param values values copied by native library
+     * @return decoded snapshot
+     */
+    public static ConnectionStatistics parse(long[] values) {
+        if (values.length < HEADER_LENGTH || values[0] != VERSION) {
+            throw new IllegalArgumentException("Unsupported format of connection statistics");
+        }
+        int byteSlots = (int) values[1];
+        int protocolSlots = (int) values[2];
+        int cipherSlots = (int) values[3];
+
+        int position = HEADER_LENGTH;
+        Map<StatPolicy, Long> statPolicies = parseBytes(values, position, byteSlots, StatPolicy.class,
+            slot -> StatPolicy.valueOf((byte) slot), StatPolicy.UNRECOGNIZED);
+        position += byteSlots;
+        Map<StatConn, Long> statConns = parseBytes(values, position, byteSlots, StatConn.class,
+            slot -> StatConn.valueOf((byte) slot), StatConn.UNRECOGNIZED);
+        position += byteSlots;
+        Map<Fips140, Long> fips140s = parseBytes(values, position, byteSlots, Fips140.class,
+            slot -> Fips140.valueOf((byte) slot), Fips140.UNRECOGNIZED);
+        position += byteSlots;
+        // the last slot counts unknown versions of protocol
+        Map<Protocol, Long> protocols = parse(values, position, protocolSlots, Protocol.class, slot -> {
+            if (slot == protocolSlots - 1) return null;
+            return Protocol.valueOf((byte) (slot / PROTOCOL_MODS), (byte) (slot % PROTOCOL_MODS));
+        }, Protocol.UNRECOGNIZED);
+        position += protocolSlots;
+
+        Map<String, Long> ciphers = new TreeMap<>();
+        for (int i = 0; i < cipherSlots; i++) {
+            long key = values[position + 2 * i];
+            long count = values[position + 2 * i + 1];
+            if ((key != 0) && (count != 0)) ciphers.put(String.format(Locale.ROOT, "%04X", key - 1), count);
+        }
+
+        return new ConnectionStatistics(
+            values[4], statPolicies, statConns, fips140s, protocols, Collections.unmodifiableMap(ciphers), values[5]
+        );
+    }
+
+    /**
+     * Single-byte values are counted by the value, the last slot counts all other values
+     */
+    private static <E extends Enum<E>> Map<E, Long> parseBytes(
+        long[] values, int position, int slots, Class<E> clazz, IntFunction<E> valueOf, E unrecognized
+    ) {
+        IntFunction<E> bySlot = slot -> slot == slots - 1 ? null : valueOf.apply(slot);
+        return parse(values, position, slots, clazz, bySlot, unrecognized);
+    }
+
+    private static <E extends Enum<E>> Map<E, Long> parse(
+        long[] values, int position, int slots, Class<E> clazz, IntFunction<E> valueOf, E unrecognized
+    ) {
+        Map<E, Long> out = new EnumMap<>(clazz);
+        for (int slot = 0; slot < slots; slot++) {
+            long count = values[position + slot];
+            if (count == 0) continue;
+
+            E key = valueOf.apply(slot);
+            out.merge(key == null ? unrecognized : key, count, Long::sum);
+        }
+        return Collections.unmodifiableMap(out);
+    }
+
+    /**
+     * @return count of secure connections (handshake was finished)
+     */
+    public long getSecured() {
+        return statConns.getOrDefault(StatConn.SECURE, 0L);
+    }
+
+    /**
+     * @return share of secure connections (between 0 and 1)
+     */
+    public double getSecuredShare() {
+        return connections == 0 ? 0 : (double) getSecured() / connections;
+    }
+
+    /**
+     * @return counts of ciphers which are known by this library, unknown ciphers are skipped
+     */
+    public Map<CipherSuite, Long> getCipherSuites() {
+        Map<CipherSuite, Long> out = new EnumMap<>(CipherSuite.class);
+        ciphers.forEach((code, count) -> {
+            CipherSuite suite = CipherSuite.valueOfCode(code);
+            if (suite != null) out.merge(suite, count, Long::sum);
+        });
+        return out;
+    }
+
+}
@@ -37,7 +37,13 @@ public enum Fips140 {
         /**
          * FIPS 140 Level3 is set
          */
-        TTLS_FIPS140_LEVEL3((byte) 4)
+        TTLS_FIPS140_LEVEL3((byte) 4),
+
+        /**
+         * Value is not known by this library (AT-TLS is newer), it is returned instead of exception in tolerant mode,
+         * see {@link AttlsContext#setTolerateUnknownValues(boolean)}
+         */
+        UNRECOGNIZED((byte) -1)
 
     ;
 
@@ -46,7 +52,7 @@ public enum Fips140 {
 
     public static Fips140 valueOf(byte value) {
         for (Fips140 fips140 : values()) {
-            if (fips140.value == value) return fips140;
+            if ((fips140 != UNRECOGNIZED) && (fips140.value == value)) return fips140;
         }
 
         return null;
@@ -11,6 +11,11 @@ package org.zowe.commons.attls;
 
 import lombok.Setter;
 import lombok.experimental.UtilityClass;
+import org.zowe.commons.usermap.CertificateResponse;
+import org.zowe.commons.x509.CertificateInfo;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.CompletableFuture;
 
 /**
  * This class collects incoming calls and its AT-TLS context. By thread is possible to get context anywhere or directly
@@ -31,23 +36,58 @@ public class InboundAttls {
     @Setter
     private static boolean alwaysLoadCertificate;
 
+    /**
+     * If this value is true, AT-TLS request and certificate of each incoming session are stored in native memory (see
+     * {@link AttlsContext#AttlsContext(int, boolean, boolean)}).
+     */
+    @Setter
+    private static boolean directMemory;
+
+    /**
+     * If this value is true, the query (and the certificate if alwaysLoadCertificate is set) is fetched asynchronously
+     * right after {@link #init(int)}, see {@link AttlsContext#queryAsync()}. Static getters of this class wait for the
+     * prefetched data, see also {@link #getAsync()}.
+     */
+    @Setter
+    private static boolean prefetch;
+
+    /**
+     * If it is set, contexts are taken from the pool in {@link #init(int)} and returned in {@link #dispose()}. The pool
+     * settings are used instead of alwaysLoadCertificate and directMemory.
+     */
+    @Setter
+    private static AttlsContextPool pool;
+
     /**
      * Initialize context for this thread
      * @param id file description of socket
      */
     public static void init(int id) {
-        contexts.set(new AttlsContext(id, alwaysLoadCertificate));
+        AttlsContextPool currentPool = pool;
+        AttlsContext context = currentPool != null ? currentPool.acquire(id) : new AttlsContext(id, alwaysLoadCertificate, directMemory);
+        contexts.set(context);
+        if (prefetch) context.queryAsync();
     }
 
     /**
-     * Clean context for this thread
+     * Clean context for this thread (see {@link AttlsContext#clean()}). If a pool is set, the context is reset and
+     * returned into the pool instead.
      */
     public static void dispose() {
+        AttlsContext context = contexts.get();
         contexts.remove();
+        if (context == null) return;
+        AttlsContextPool currentPool = pool;
+        if (currentPool != null) {
+            currentPool.release(context);
+        } else {
+            context.clean();
+        }
     }
 
     /**
-     * Get AT-TLS context for this thread
+     * Get AT-TLS context for this thread. It does not wait for prefetched data, getters of the context must not be
+     * called until {@link AttlsContext#whenReady()} (or {@link #getAsync()}) is completed.
      * @return current AttlsContext
      * @throws ContextIsNotInitializedException when no context was initialized
      */
@@ -57,6 +97,25 @@ public class InboundAttls {
         return context;
     }
 
+    /**
+     * Get AT-TLS context for this thread when its pending asynchronous calls (ie. prefetch) are finished
+     * @return future of current AttlsContext
+     * @throws ContextIsNotInitializedException when no context was initialized
+     */
+    public static CompletableFuture<AttlsContext> getAsync() throws ContextIsNotInitializedException {
+        return get().whenReady();
+    }
+
+    /**
+     * Returns the context to call its getter. Static getters of this class block anyway, so they wait for prefetched
+     * data here.
+     */
+    private static AttlsContext ready() throws ContextIsNotInitializedException {
+        AttlsContext context = get();
+        context.awaitAsync();
+        return context;
+    }
+
     /**
      * Call {@link AttlsContext#clean()} for incoming call of this thread.
      * @throws ContextIsNotInitializedException when no context was initialized
@@ -73,11 +132,11 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static StatPolicy getStatPolicy() throws ContextIsNotInitializedException, UnknownEnumValueException, IoctlCallException {
-        return get().getStatPolicy();
+        return ready().getStatPolicy();
     }
 
     public static StatConn getStatConn() throws ContextIsNotInitializedException, UnknownEnumValueException, IoctlCallException {
-        return get().getStatConn();
+        return ready().getStatConn();
     }
 
     /**
@@ -88,7 +147,7 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static Protocol getProtocol() throws ContextIsNotInitializedException, IoctlCallException, UnknownEnumValueException {
-        return get().getProtocol();
+        return ready().getProtocol();
     }
 
     /**
@@ -98,7 +157,7 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static String getNegotiatedCipher2() throws ContextIsNotInitializedException, IoctlCallException {
-        return get().getNegotiatedCipher2();
+        return ready().getNegotiatedCipher2();
     }
 
     /**
@@ -109,7 +168,7 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static SecurityType getSecurityType() throws ContextIsNotInitializedException, IoctlCallException, UnknownEnumValueException {
-        return get().getSecurityType();
+        return ready().getSecurityType();
     }
 
     /**
@@ -119,7 +178,7 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static String getUserId() throws ContextIsNotInitializedException, IoctlCallException {
-        return get().getUserId();
+        return ready().getUserId();
     }
 
     /**
@@ -130,7 +189,7 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static Fips140 getFips140() throws ContextIsNotInitializedException, IoctlCallException, UnknownEnumValueException {
-        return get().getFips140();
+        return ready().getFips140();
     }
 
     /**
@@ -140,7 +199,7 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static byte getFlags() throws ContextIsNotInitializedException, IoctlCallException {
-        return get().getFlags();
+        return ready().getFlags();
     }
 
     /**
@@ -150,7 +209,47 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static String getNegotiatedCipher4() throws ContextIsNotInitializedException, IoctlCallException {
-        return get().getNegotiatedCipher4();
+        return ready().getNegotiatedCipher4();
+    }
+
+    /**
+     * Call {@link AttlsContext#getNegotiatedKeyShare()} for incoming call of this thread.
+     * @return negotiated key share group, or null if it is not available
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static String getNegotiatedKeyShare() throws ContextIsNotInitializedException, IoctlCallException {
+        return ready().getNegotiatedKeyShare();
+    }
+
+    /**
+     * Call {@link AttlsContext#getCipherSuite()} for incoming call of this thread.
+     * @return negotiated cipher suite, or null if the cipher is not known
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static CipherSuite getCipherSuite() throws ContextIsNotInitializedException, IoctlCallException {
+        return ready().getCipherSuite();
+    }
+
+    /**
+     * Call {@link AttlsContext#getPackedStatus()} for incoming call of this thread.
+     * @return packed status, see {@link PackedStatus}
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static long getPackedStatus() throws ContextIsNotInitializedException, IoctlCallException {
+        return ready().getPackedStatus();
+    }
+
+    /**
+     * Call {@link AttlsContext#tryQuery(long[])} for incoming call of this thread.
+     * @param status array for the packed status and errno2 (it could be null)
+     * @return 0 on success, otherwise errno of ioctl
+     * @throws ContextIsNotInitializedException when no context was initialized
+     */
+    public static int tryQuery(long[] status) throws ContextIsNotInitializedException {
+        return ready().tryQuery(status);
     }
 
     /**
@@ -160,7 +259,68 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static byte[] getCertificate() throws ContextIsNotInitializedException, IoctlCallException {
-        return get().getCertificate();
+        return ready().getCertificate();
+    }
+
+    /**
+     * Call {@link AttlsContext#getCertificate(byte[], int)} for incoming call of this thread.
+     * @param dst target array
+     * @param off offset in the target array
+     * @return length of certificate, if it is bigger than the free space of dst nothing is copied
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static int getCertificate(byte[] dst, int off) throws ContextIsNotInitializedException, IoctlCallException {
+        return ready().getCertificate(dst, off);
+    }
+
+    /**
+     * Call {@link AttlsContext#getCertificate(ByteBuffer)} for incoming call of this thread.
+     * @param dst target buffer
+     * @return length of certificate, if it is bigger than the remaining space of dst nothing is copied
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static int getCertificate(ByteBuffer dst) throws ContextIsNotInitializedException, IoctlCallException {
+        return ready().getCertificate(dst);
+    }
+
+    /**
+     * Call {@link AttlsContext#getCertificateInfo()} for incoming call of this thread.
+     * @return basic fields of partner certificate
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static CertificateInfo getCertificateInfo() throws ContextIsNotInitializedException, IoctlCallException {
+        return ready().getCertificateInfo();
+    }
+
+    /**
+     * Call {@link AttlsContext#mapCertificateToUserId()} for incoming call of this thread.
+     * @return mapped user ID and status of the mapping
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static CertificateResponse mapCertificateToUserId() throws ContextIsNotInitializedException, IoctlCallException {
+        return ready().mapCertificateToUserId();
+    }
+
+    /**
+     * Call {@link AttlsContext#queryAsync()} for incoming call of this thread.
+     * @return future of the context with loaded query data
+     * @throws ContextIsNotInitializedException when no context was initialized
+     */
+    public static CompletableFuture<AttlsContext> queryAsync() throws ContextIsNotInitializedException {
+        return get().queryAsync();
+    }
+
+    /**
+     * Call {@link AttlsContext#getCertificateAsync()} for incoming call of this thread.
+     * @return future of partner certificate
+     * @throws ContextIsNotInitializedException when no context was initialized
+     */
+    public static CompletableFuture<byte[]> getCertificateAsync() throws ContextIsNotInitializedException {
+        return get().getCertificateAsync();
     }
 
     /**
@@ -169,7 +329,7 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static void resetSession() throws ContextIsNotInitializedException, IoctlCallException {
-        get().resetSession();
+        ready().resetSession();
     }
 
     /**
@@ -178,7 +338,27 @@ public class InboundAttls {
      * @throws IoctlCallException unexpected error in call of ioctl
      */
     public static void resetCipher() throws ContextIsNotInitializedException, IoctlCallException {
-        get().resetCipher();
+        ready().resetCipher();
+    }
+
+    /**
+     * Call {@link AttlsContext#resetSessionAndQuery(boolean)} for incoming call of this thread.
+     * @param certificate if set true, the partner certificate is fetched too
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static void resetSessionAndQuery(boolean certificate) throws ContextIsNotInitializedException, IoctlCallException {
+        ready().resetSessionAndQuery(certificate);
+    }
+
+    /**
+     * Call {@link AttlsContext#resetCipherAndQuery(boolean)} for incoming call of this thread.
+     * @param certificate if set true, the partner certificate is fetched too
+     * @throws ContextIsNotInitializedException when no context was initialized
+     * @throws IoctlCallException unexpected error in call of ioctl
+     */
+    public static void resetCipherAndQuery(boolean certificate) throws ContextIsNotInitializedException, IoctlCallException {
+        ready().resetCipherAndQuery(certificate);
     }
 
 }
@@ -0,0 +1,115 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import lombok.experimental.UtilityClass;
+
+/**
+ * Decoder of value returned by {@link AttlsContext#getPackedStatus()}. All primitive values of the query are packed into
+ * one long to be fetched by one native call without creating any Java object. Each byte holds one value (from the
+ * lowest):
+ * <ul>
+ *     <li>0 - policy status, see {@link StatPolicy}</li>
+ *     <li>1 - connection status, see {@link StatConn}</li>
+ *     <li>2 - version of protocol, see {@link Protocol#getVersion()}</li>
+ *     <li>3 - modifier of protocol, see {@link Protocol#getMod()}</li>
+ *     <li>4 - security type, see {@link SecurityType}</li>
+ *     <li>5 - level of FIPS compliance, see {@link Fips140}</li>
+ *     <li>6 - AT-TLS flags</li>
+ *     <li>7 - length of partner user ID (0 if it is not available)</li>
+ * </ul>
+ * Methods returning bytes do not create any object and they are suitable for hot path. Methods returning enumerations
+ * are just a shortcut for conversion.
+ */
+@UtilityClass
+public class PackedStatus {
+
+    public static final int STAT_POLICY_SHIFT = 0;
+    public static final int STAT_CONN_SHIFT = 8;
+    public static final int PROTOCOL_VERSION_SHIFT = 16;
+    public static final int PROTOCOL_MOD_SHIFT = 24;
+    public static final int SECURITY_TYPE_SHIFT = 32;
+    public static final int FIPS_140_SHIFT = 40;
+    public static final int FLAGS_SHIFT = 48;
+    public static final int USER_ID_LENGTH_SHIFT = 56;
+
+    private static byte getByte(long status, int shift) {
+        return (byte) (status >>> shift);
+    }
+
+    public static byte getStatPolicy(long status) {
+        return getByte(status, STAT_POLICY_SHIFT);
+    }
+
+    public static byte getStatConn(long status) {
+        return getByte(status, STAT_CONN_SHIFT);
+    }
+
+    public static byte getProtocolVersion(long status) {
+        return getByte(status, PROTOCOL_VERSION_SHIFT);
+    }
+
+    public static byte getProtocolMod(long status) {
+        return getByte(status, PROTOCOL_MOD_SHIFT);
+    }
+
+    public static byte getSecurityType(long status) {
+        return getByte(status, SECURITY_TYPE_SHIFT);
+    }
+
+    public static byte getFips140(long status) {
+        return getByte(status, FIPS_140_SHIFT);
+    }
+
+    public static byte getFlags(long status) {
+        return getByte(status, FLAGS_SHIFT);
+    }
+
+    public static int getUserIdLength(long status) {
+        return getByte(status, USER_ID_LENGTH_SHIFT) & 0xff;
+    }
+
+    /**
+     * @param status packed status
+     * @return true if connection is secure ({@link StatConn#SECURE})
+     */
+    public static boolean isSecure(long status) {
+        return getStatConn(status) == StatConn.SECURE.getValue();
+    }
+
+    /**
+     * @param status packed status
+     * @return true if AT-TLS provided partner user ID
+     */
+    public static boolean hasUserId(long status) {
+        return getUserIdLength(status) > 0;
+    }
+
+    public static StatPolicy toStatPolicy(long status) {
+        return StatPolicy.valueOf(getStatPolicy(status));
+    }
+
+    public static StatConn toStatConn(long status) {
+        return StatConn.valueOf(getStatConn(status));
+    }
+
+    public static Protocol toProtocol(long status) {
+        return Protocol.valueOf(getProtocolVersion(status), getProtocolMod(status));
+    }
+
+    public static SecurityType toSecurityType(long status) {
+        return SecurityType.valueOf(getSecurityType(status));
+    }
+
+    public static Fips140 toFips140(long status) {
+        return Fips140.valueOf(getFips140(status));
+    }
+
+}
@@ -46,7 +46,13 @@ public enum Protocol {
         /**
          * TLS Version 1.3
          */
-        TLS1_3((byte) 3, (byte) 4)
+        TLS1_3((byte) 3, (byte) 4),
+
+        /**
+         * Value is not known by this library (AT-TLS is newer), it is returned instead of exception in tolerant mode,
+         * see {@link AttlsContext#setTolerateUnknownValues(boolean)}
+         */
+        UNRECOGNIZED((byte) -1, (byte) -1)
 
     ;
 
@@ -57,7 +63,7 @@ public enum Protocol {
 
     public static Protocol valueOf(byte version, byte mod) {
         for (Protocol protocol : values()) {
-            if ((protocol.mod == mod) && (protocol.version == version)) return protocol;
+            if ((protocol != UNRECOGNIZED) && (protocol.mod == mod) && (protocol.version == version)) return protocol;
         }
 
         return null;
@@ -46,7 +46,13 @@ public enum SecurityType {
         /**
          * Server with client authentication, ClientAuthType = SAFCheck
          */
-        TTLS_SEC_SRV_CA_SAFCHK((byte) 6)
+        TTLS_SEC_SRV_CA_SAFCHK((byte) 6),
+
+        /**
+         * Value is not known by this library (AT-TLS is newer), it is returned instead of exception in tolerant mode,
+         * see {@link AttlsContext#setTolerateUnknownValues(boolean)}
+         */
+        UNRECOGNIZED((byte) -1)
 
     ;
 
@@ -55,7 +61,7 @@ public enum SecurityType {
 
     public static SecurityType valueOf(byte value) {
         for (SecurityType securityType : values()) {
-            if (securityType.value == value) return securityType;
+            if ((securityType != UNRECOGNIZED) && (securityType.value == value)) return securityType;
         }
 
         return null;
@@ -29,7 +29,13 @@ public enum StatConn {
         /**
          * Connection is secure
          */
-        SECURE((byte) 3)
+        SECURE((byte) 3),
+
+        /**
+         * Value is not known by this library (AT-TLS is newer), it is returned instead of exception in tolerant mode,
+         * see {@link AttlsContext#setTolerateUnknownValues(boolean)}
+         */
+        UNRECOGNIZED((byte) -1)
 
     ;
 
@@ -38,7 +44,7 @@ public enum StatConn {
 
     public static StatConn valueOf(byte value) {
         for (StatConn statConn : values()) {
-            if (statConn.value == value) return statConn;
+            if ((statConn != UNRECOGNIZED) && (statConn.value == value)) return statConn;
         }
         return null;
     }
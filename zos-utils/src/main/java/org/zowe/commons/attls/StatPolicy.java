@@ -37,7 +37,13 @@ public enum StatPolicy {
         /**
          * Policy defined for connection - AT-TLS enabled and Application Controlled
          */
-        APPLCNTRL((byte) 5)
+        APPLCNTRL((byte) 5),
+
+        /**
+         * Value is not known by this library (AT-TLS is newer), it is returned instead of exception in tolerant mode,
+         * see {@link AttlsContext#setTolerateUnknownValues(boolean)}
+         */
+        UNRECOGNIZED((byte) -1)
 
     ;
 
@@ -46,7 +52,7 @@ public enum StatPolicy {
 
     public static StatPolicy valueOf(byte value) {
         for (StatPolicy statPolicy : values()) {
-            if (statPolicy.value == value) return statPolicy;
+            if ((statPolicy != UNRECOGNIZED) && (statPolicy.value == value)) return statPolicy;
         }
         return null;
     }
@@ -9,20 +9,32 @@
  */
 package org.zowe.commons.attls;
 
+import lombok.AllArgsConstructor;
 import lombok.Value;
 
 /**
  * This exception could be thrown from AT-TLS context ({@link org.zowe.commons.attls.AttlsContext}), when ioctl returns
  * value which is not defined in the Enum. It indicated, that library is older the AT-TLS implementation and it is
- * required to upgrade this library
+ * required to upgrade this library. To get a sentinel value instead of the exception, see
+ * {@link AttlsContext#setTolerateUnknownValues(boolean)}.
  */
 @Value
+@AllArgsConstructor
 public class UnknownEnumValueException extends Exception {
 
     private static final long serialVersionUID = 8662184734113422578L;
 
-    private final Enum<?> enumClazz;
+    private final Class<? extends Enum<?>> enumClazz;
     private final byte value;
     private final byte value2;
 
+    /**
+     * Exception of enumeration identified by one byte
+     * @param enumClazz class of enumeration
+     * @param value unknown value
+     */
+    public UnknownEnumValueException(Class<? extends Enum<?>> enumClazz, byte value) {
+        this(enumClazz, value, (byte) 0);
+    }
+
 }
@@ -0,0 +1,27 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.usermap;
+
+import lombok.Value;
+
+/**
+ * Counters of cache of user mapping
+ */
+@Value
+public class CacheStatistics {
+
+    long hits;
+    long misses;
+    long evictions;
+    long expirations;
+    int size;
+
+}
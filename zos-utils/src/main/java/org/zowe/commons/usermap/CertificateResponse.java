@@ -15,9 +15,21 @@ import lombok.Value;
 @Value
 public class CertificateResponse {
 
+    /**
+     * Value of errno (ESRCH on z/OS) when the certificate is not associated with any user ID
+     */
+    public static final int ERRNO_NOT_MAPPED = 143;
+
     String userId;
     int rc;
     int errno;
     int errno2;
 
+    /**
+     * @return true if the certificate was processed, but it is not mapped to any user ID
+     */
+    public boolean isNotMapped() {
+        return (rc != 0) && (errno == ERRNO_NOT_MAPPED);
+    }
+
 }
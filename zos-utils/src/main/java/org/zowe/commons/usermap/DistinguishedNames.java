@@ -0,0 +1,137 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.usermap;
+
+import lombok.experimental.UtilityClass;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Locale;
+
+/**
+ * Canonicalisation of distinguished names. Equivalent names sent in a different form (ie. by different proxies) have
+ * the same canonical form:
+ * <ul>
+ *     <li>RDNs can be separated by comma or semicolon, the canonical form uses comma</li>
+ *     <li>whitespaces around separators and at the edges of values are removed, other sequences of whitespaces are
+ *     replaced by one space</li>
+ *     <li>attribute types and values are converted to lower case, except quoted values and escaped characters</li>
+ *     <li>attributes of multi-valued RDN (separated by plus) are sorted</li>
+ * </ul>
+ * Escaped characters (with backslash) and quoted values are kept as they are.
+ * <p>
+ * Canonical form is used as a key to cache, it is not sent to SAF.
+ */
+@UtilityClass
+public class DistinguishedNames {
+
+    private static final char ESCAPE = '\\';
+    private static final char QUOTE = '"';
+
+    /**
+     * Returns canonical form of distinguished name
+     * @param dn distinguished name
+     * @return canonical form of the name
+     */
+    public static String canonicalize(String dn) {
+        if (dn == null) return null;
+
+        StringBuilder output = new StringBuilder(dn.length());
+        List<String> attributes = new ArrayList<>(1);
+        StringBuilder attribute = new StringBuilder();
+        boolean quoted = false;
+        boolean escaped = false;
+        for (int i = 0; i < dn.length(); i++) {
+            char c = dn.charAt(i);
+            if (escaped) {
+                attribute.append(c);
+                escaped = false;
+            } else if (c == ESCAPE) {
+                attribute.append(c);
+                escaped = true;
+            } else if (c == QUOTE) {
+                attribute.append(c);
+                quoted = !quoted;
+            } else if (quoted) {
+                attribute.append(c);
+            } else if (c == '+') {
+                attributes.add(normalizeAttribute(attribute));
+                attribute.setLength(0);
+            } else if ((c == ',') || (c == ';')) {
+                attributes.add(normalizeAttribute(attribute));
+                attribute.setLength(0);
+                appendRdn(output, attributes);
+                output.append(',');
+            } else {
+                attribute.append(Character.toLowerCase(c));
+            }
+        }
+        attributes.add(normalizeAttribute(attribute));
+        appendRdn(output, attributes);
+
+        return output.toString();
+    }
+
+    /**
+     * Returns canonical form of registry name (without whitespaces at the edges and in lower case)
+     * @param registry name of registry
+     * @return canonical form of registry name
+     */
+    public static String canonicalizeRegistry(String registry) {
+        if (registry == null) return null;
+        return registry.trim().toLowerCase(Locale.ROOT);
+    }
+
+    private static void appendRdn(StringBuilder output, List<String> attributes) {
+        if (attributes.size() > 1) Collections.sort(attributes);
+        for (int i = 0; i < attributes.size(); i++) {
+            if (i > 0) output.append('+');
+            output.append(attributes.get(i));
+        }
+        attributes.clear();
+    }
+
+    /**
+     * Normalizes whitespaces in the attribute (type=value) - out of quotes and escaped characters
+     */
+    private static String normalizeAttribute(StringBuilder attribute) {
+        StringBuilder output = new StringBuilder(attribute.length());
+        boolean quoted = false;
+        boolean escaped = false;
+        boolean space = false;
+        for (int i = 0; i < attribute.length(); i++) {
+            char c = attribute.charAt(i);
+            if (!escaped && !quoted && Character.isWhitespace(c)) {
+                space = true;
+                continue;
+            }
+
+            // keep one space between words, but not at the edges and around the equal sign
+            int last = output.length() - 1;
+            if (space && (last >= 0) && (output.charAt(last) != '=') && ((c != '=') || escaped)) {
+                output.append(' ');
+            }
+            space = false;
+
+            if (escaped) {
+                escaped = false;
+            } else if (c == ESCAPE) {
+                escaped = true;
+            } else if (c == QUOTE) {
+                quoted = !quoted;
+            }
+            output.append(c);
+        }
+        return output.toString();
+    }
+
+}
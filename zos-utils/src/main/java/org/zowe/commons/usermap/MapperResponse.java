@@ -14,9 +14,26 @@ import lombok.Value;
 
 @Value
 public class MapperResponse {
+
+    /**
+     * Return and reason codes of R_usermap when there is no mapping of the distinguished name to a user ID
+     */
+    public static final int SAF_RC_NOT_MAPPED = 8;
+    public static final int RACF_RC_NOT_MAPPED = 8;
+    public static final int RACF_RS_NOT_MAPPED = 48;
+
     String userId;
     int rc;
     int safRc;
     int racfRc;
     int racfRs;
+
+    /**
+     * @return true if the name was processed, but it is not mapped to any user ID
+     */
+    public boolean isNotMapped() {
+        return (rc != 0) && (safRc == SAF_RC_NOT_MAPPED) && (racfRc == RACF_RC_NOT_MAPPED)
+            && (racfRs == RACF_RS_NOT_MAPPED);
+    }
+
 }
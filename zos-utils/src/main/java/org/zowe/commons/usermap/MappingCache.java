@@ -0,0 +1,119 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.usermap;
+
+import lombok.AllArgsConstructor;
+
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.function.LongSupplier;
+
+/**
+ * Bounded LRU cache of results of user mapping. Each entry has its own time of expiration, an expired entry is never
+ * returned and it is removed on the first access after expiration. The least recently used entry is evicted when the
+ * cache is full.
+ *
+ * @param <K> type of key
+ * @param <V> type of cached result
+ */
+class MappingCache<K, V> {
+
+    private final int maxSize;
+    private final LongSupplier nanoTime;
+    private final LinkedHashMap<K, Entry<V>> entries;
+
+    private final LongAdder hits = new LongAdder();
+    private final LongAdder misses = new LongAdder();
+    private final LongAdder evictions = new LongAdder();
+    private final LongAdder expirations = new LongAdder();
+
+    MappingCache(int maxSize) {
+        this(maxSize, System::nanoTime);
+    }
+
+    MappingCache(int maxSize, LongSupplier nanoTime) {
+        if (maxSize <= 0) throw new IllegalArgumentException("Size of cache must be positive");
+
+        this.maxSize = maxSize;
+        this.nanoTime = nanoTime;
+        this.entries = new LinkedHashMap<K, Entry<V>>(16, 0.75f, true) {
+
+            private static final long serialVersionUID = -1698513430475384815L;
+
+            @Override
+            protected boolean removeEldestEntry(Map.Entry<K, Entry<V>> eldest) {
+                if (size() <= MappingCache.this.maxSize) return false;
+                evictions.increment();
+                return true;
+            }
+
+        };
+    }
+
+    /**
+     * Returns cached value or null if there is no valid entry for the key
+     * @param key key of entry
+     * @return cached value or null
+     */
+    V get(K key) {
+        long now = nanoTime.getAsLong();
+        synchronized (this) {
+            Entry<V> entry = entries.get(key);
+            if (entry != null) {
+                if (now - entry.expiresAt < 0) {
+                    hits.increment();
+                    return entry.value;
+                }
+                entries.remove(key);
+                expirations.increment();
+            }
+        }
+        misses.increment();
+        return null;
+    }
+
+    /**
+     * Stores the value for the time to live. If time to live is not positive, value is not stored.
+     * @param key key of entry
+     * @param value value to cache
+     * @param ttlNanos time to live in nanoseconds
+     */
+    void put(K key, V value, long ttlNanos) {
+        if (ttlNanos <= 0) return;
+
+        Entry<V> entry = new Entry<>(value, nanoTime.getAsLong() + ttlNanos);
+        synchronized (this) {
+            entries.put(key, entry);
+        }
+    }
+
+    synchronized void clear() {
+        entries.clear();
+    }
+
+    synchronized int size() {
+        return entries.size();
+    }
+
+    CacheStatistics getStatistics() {
+        return new CacheStatistics(hits.sum(), misses.sum(), evictions.sum(), expirations.sum(), size());
+    }
+
+    @AllArgsConstructor
+    private static final class Entry<V> {
+
+        private final V value;
+        private final long expiresAt;
+
+    }
+
+}
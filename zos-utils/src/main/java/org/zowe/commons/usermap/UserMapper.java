@@ -10,17 +10,349 @@
 
 package org.zowe.commons.usermap;
 
+import lombok.EqualsAndHashCode;
+import lombok.RequiredArgsConstructor;
+import org.zowe.commons.x509.CertificateInfo;
+import org.zowe.commons.zos.NativeLibraryLoader;
+
+import java.nio.ByteBuffer;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.function.Supplier;
+
+/**
+ * Mapping of certificates and distinguished names to user IDs by SAF.
+ * <p>
+ * Instance created with {@link UserMapperCacheConfig} caches results of certificate mapping. The key is SHA-256 digest
+ * of the certificate. Successful mappings are cached for {@link UserMapperCacheConfig#getTtl()}, unmapped certificates
+ * (see {@link CertificateResponse#isNotMapped()}) for {@link UserMapperCacheConfig#getNegativeTtl()}. Other failures
+ * are not cached.
+ * <p>
+ * Results of distinguished name mapping are cached the same way, in a separate partition for each registry (up to
+ * {@link UserMapperCacheConfig#getMaxRegistries()}, names in other registries are not cached). The key is canonical form
+ * of the name (see {@link DistinguishedNames#canonicalize(String)}), so equivalent names written in a different form
+ * share the same entry.
+ * <p>
+ * Inputs could be passed in direct buffers (certificates as DER, distinguished names and registries in EBCDIC), SAF
+ * reads them in place without any copy.
+ */
 public class UserMapper {
 
     public static final String USERMAP_LIBRARY_NAME = "zowe-usermap";
 
+    private static final String DIGEST_ALGORITHM = "SHA-256";
+
+    private static final String CERTIFICATE_IS_NULL = "Certificate cannot be null";
+    private static final String CERTIFICATES_ARE_NULL = "Certificates cannot be null";
+    private static final String DN_IS_NULL = "Distinguished name cannot be null";
+    private static final String DNS_ARE_NULL = "Distinguished names cannot be null";
+    private static final String REGISTRY_IS_NULL = "Registry cannot be null";
+
+    private static final ThreadLocal<MessageDigest> DIGEST = ThreadLocal.withInitial(() -> {
+        try {
+            return MessageDigest.getInstance(DIGEST_ALGORITHM);
+        } catch (NoSuchAlgorithmException e) {
+            throw new IllegalStateException("Algorithm " + DIGEST_ALGORITHM + " is not available", e);
+        }
+    });
+
     static {
-        if ("z/os".equalsIgnoreCase(System.getProperty("os.name"))) {
-            System.loadLibrary(USERMAP_LIBRARY_NAME);
+        NativeLibraryLoader.load(USERMAP_LIBRARY_NAME);
+    }
+
+    private final MappingCache<CertificateKey, CertificateResponse> certificateCache;
+    private final Map<String, MappingCache<String, MapperResponse>> dnCaches;
+    private final int maxSize;
+    private final int maxRegistries;
+    private final long ttlNanos;
+    private final long negativeTtlNanos;
+
+    /**
+     * Create mapper without any cache, each call is processed by SAF.
+     */
+    public UserMapper() {
+        this.certificateCache = null;
+        this.dnCaches = null;
+        this.maxSize = 0;
+        this.maxRegistries = 0;
+        this.ttlNanos = 0;
+        this.negativeTtlNanos = 0;
+    }
+
+    /**
+     * Create mapper with cache of results
+     * @param cacheConfig configuration of cache
+     */
+    public UserMapper(UserMapperCacheConfig cacheConfig) {
+        this.certificateCache = new MappingCache<>(cacheConfig.getMaxSize());
+        this.dnCaches = new ConcurrentHashMap<>();
+        this.maxSize = cacheConfig.getMaxSize();
+        this.maxRegistries = cacheConfig.getMaxRegistries();
+        this.ttlNanos = cacheConfig.getTtl().toNanos();
+        this.negativeTtlNanos = cacheConfig.getNegativeTtl().toNanos();
+    }
+
+    /**
+     * Maps DER encoded certificate to user ID
+     * @param certificate DER encoded certificate
+     * @return result of mapping
+     * @throws IllegalArgumentException if the certificate is null
+     */
+    public CertificateResponse getUserIDForCertificate(byte[] certificate) {
+        if (certificate == null) throw new IllegalArgumentException(CERTIFICATE_IS_NULL);
+        if (certificateCache == null) return mapCertificate(certificate);
+
+        return getCachedCertificate(DIGEST.get().digest(certificate), () -> mapCertificate(certificate));
+    }
+
+    /**
+     * Maps certificate (DER) between position and limit of the buffer, the position is not changed. A direct buffer is
+     * read by SAF in place, a heap buffer is mapped as a byte array. Both share the same cache.
+     * @param certificate buffer with DER encoded certificate
+     * @return result of mapping
+     */
+    public CertificateResponse getUserIDForCertificate(ByteBuffer certificate) {
+        if (!certificate.isDirect()) return getUserIDForCertificate(toArray(certificate));
+
+        int position = certificate.position();
+        int length = certificate.remaining();
+        if (certificateCache == null) return mapCertificateDirect(certificate, position, length);
+
+        MessageDigest digest = DIGEST.get();
+        digest.update(certificate.duplicate());
+        return getCachedCertificate(digest.digest(), () -> mapCertificateDirect(certificate, position, length));
+    }
+
+    private CertificateResponse getCachedCertificate(byte[] digest, Supplier<CertificateResponse> mapping) {
+        CertificateKey key = new CertificateKey(digest);
+        CertificateResponse response = certificateCache.get(key);
+        if (response == null) {
+            response = mapping.get();
+            certificateCache.put(key, response, getTtlNanos(response.getRc(), response.isNotMapped()));
+        }
+        return response;
+    }
+
+    private static byte[] toArray(ByteBuffer buffer) {
+        byte[] out = new byte[buffer.remaining()];
+        buffer.duplicate().get(out);
+        return out;
+    }
+
+    /**
+     * Maps distinguished name in registry to user ID
+     * @param distinguishedName distinguished name (up to 246 characters in EBCDIC)
+     * @param registry name of registry (up to 255 characters in EBCDIC)
+     * @return result of mapping
+     * @throws IllegalArgumentException if a value is null or too long
+     */
+    public MapperResponse getUserIDForDN(String distinguishedName, String registry) {
+        if (registry == null) throw new IllegalArgumentException(REGISTRY_IS_NULL);
+        if (distinguishedName == null) throw new IllegalArgumentException(DN_IS_NULL);
+
+        MappingCache<String, MapperResponse> dnCache = getDnCache(registry);
+        if (dnCache == null) return mapDN(distinguishedName, registry);
+
+        String key = DistinguishedNames.canonicalize(distinguishedName);
+        MapperResponse response = dnCache.get(key);
+        if (response == null) {
+            response = mapDN(distinguishedName, registry);
+            dnCache.put(key, response, getTtlNanos(response.getRc(), response.isNotMapped()));
         }
+        return response;
+    }
+
+    /**
+     * Maps distinguished name in registry. Both values are in EBCDIC between position and limit of direct buffers (the
+     * positions are not changed), SAF reads them in place. The result is not cached, because the cache is keyed by
+     * canonical form of the name.
+     * @param distinguishedName direct buffer with distinguished name in EBCDIC (up to 246 bytes)
+     * @param registry direct buffer with name of registry in EBCDIC (up to 255 bytes)
+     * @return result of mapping
+     * @throws IllegalArgumentException if a buffer is not direct or a value is too long
+     */
+    public MapperResponse getUserIDForDN(ByteBuffer distinguishedName, ByteBuffer registry) {
+        return mapDNDirect(
+            distinguishedName, distinguishedName.position(), distinguishedName.remaining(),
+            registry, registry.position(), registry.remaining()
+        );
     }
 
-    public native CertificateResponse getUserIDForCertificate(byte[] certificate);
+    /**
+     * Maps all certificates to user IDs. All certificates (which are not cached) are mapped in one native call.
+     * @param certificates certificates to map
+     * @return results of mapping in the same order as certificates
+     * @throws IllegalArgumentException if the array or any of certificates is null
+     */
+    public CertificateResponse[] getUserIDsForCertificates(byte[][] certificates) {
+        requireElements(certificates, CERTIFICATES_ARE_NULL, CERTIFICATE_IS_NULL);
+        if (certificateCache == null) return mapCertificates(certificates);
+
+        CertificateResponse[] responses = new CertificateResponse[certificates.length];
+        CertificateKey[] keys = new CertificateKey[certificates.length];
+        int[] missing = new int[certificates.length];
+        int missingCount = 0;
+        for (int i = 0; i < certificates.length; i++) {
+            keys[i] = new CertificateKey(DIGEST.get().digest(certificates[i]));
+            responses[i] = certificateCache.get(keys[i]);
+            if (responses[i] == null) missing[missingCount++] = i;
+        }
+        if (missingCount == 0) return responses;
+
+        byte[][] toMap = new byte[missingCount][];
+        for (int i = 0; i < missingCount; i++) {
+            toMap[i] = certificates[missing[i]];
+        }
+        CertificateResponse[] mapped = mapCertificates(toMap);
+        for (int i = 0; i < missingCount; i++) {
+            int index = missing[i];
+            responses[index] = mapped[i];
+            certificateCache.put(keys[index], mapped[i], getTtlNanos(mapped[i].getRc(), mapped[i].isNotMapped()));
+        }
+        return responses;
+    }
+
+    /**
+     * Maps all distinguished names in the registry to user IDs. All names (which are not cached) are mapped in one
+     * native call.
+     * @param distinguishedNames names to map
+     * @param registry name of registry
+     * @return results of mapping in the same order as distinguished names
+     * @throws IllegalArgumentException if the array or any of names is null
+     */
+    public MapperResponse[] getUserIDsForDNs(String[] distinguishedNames, String registry) {
+        if (registry == null) throw new IllegalArgumentException(REGISTRY_IS_NULL);
+        requireElements(distinguishedNames, DNS_ARE_NULL, DN_IS_NULL);
+
+        MappingCache<String, MapperResponse> dnCache = getDnCache(registry);
+        if (dnCache == null) return mapDNs(distinguishedNames, registry);
+
+        MapperResponse[] responses = new MapperResponse[distinguishedNames.length];
+        String[] keys = new String[distinguishedNames.length];
+        int[] missing = new int[distinguishedNames.length];
+        int missingCount = 0;
+        for (int i = 0; i < distinguishedNames.length; i++) {
+            keys[i] = DistinguishedNames.canonicalize(distinguishedNames[i]);
+            responses[i] = dnCache.get(keys[i]);
+            if (responses[i] == null) missing[missingCount++] = i;
+        }
+        if (missingCount == 0) return responses;
+
+        String[] toMap = new String[missingCount];
+        for (int i = 0; i < missingCount; i++) {
+            toMap[i] = distinguishedNames[missing[i]];
+        }
+        MapperResponse[] mapped = mapDNs(toMap, registry);
+        for (int i = 0; i < missingCount; i++) {
+            int index = missing[i];
+            responses[index] = mapped[i];
+            dnCache.put(keys[index], mapped[i], getTtlNanos(mapped[i].getRc(), mapped[i].isNotMapped()));
+        }
+        return responses;
+    }
+
+    /**
+     * @return statistics of cache of certificate mapping, or null if cache is not used
+     */
+    public CacheStatistics getCertificateCacheStatistics() {
+        return certificateCache == null ? null : certificateCache.getStatistics();
+    }
+
+    /**
+     * @param registry name of registry
+     * @return statistics of cache of distinguished name mapping in the registry, or null if there is no such cache
+     */
+    public CacheStatistics getDnCacheStatistics(String registry) {
+        if (dnCaches == null) return null;
+        MappingCache<String, MapperResponse> dnCache = dnCaches.get(DistinguishedNames.canonicalizeRegistry(registry));
+        return dnCache == null ? null : dnCache.getStatistics();
+    }
+
+    /**
+     * Remove all cached results
+     */
+    public void clearCache() {
+        if (certificateCache != null) certificateCache.clear();
+        if (dnCaches != null) dnCaches.clear();
+    }
+
+    /**
+     * Returns time to live of the result. Only results of identities which are not mapped are cached negatively, other
+     * failures (ie. an error of the security product) are not cached at all.
+     */
+    private long getTtlNanos(int rc, boolean notMapped) {
+        if (rc == 0) return ttlNanos;
+        return notMapped ? negativeTtlNanos : 0;
+    }
+
+    /**
+     * Checks the array and its elements before they are digested, canonicalized or passed to the native code
+     */
+    private static void requireElements(Object[] values, String arrayMessage, String elementMessage) {
+        if (values == null) throw new IllegalArgumentException(arrayMessage);
+        for (Object value : values) {
+            if (value == null) throw new IllegalArgumentException(elementMessage);
+        }
+    }
+
+    /**
+     * Returns cache of the registry, or null if the mapper has no cache or the limit of registries was reached
+     */
+    private MappingCache<String, MapperResponse> getDnCache(String registry) {
+        if (dnCaches == null) return null;
+
+        String key = DistinguishedNames.canonicalizeRegistry(registry);
+        MappingCache<String, MapperResponse> dnCache = dnCaches.get(key);
+        if ((dnCache != null) || (dnCaches.size() >= maxRegistries)) return dnCache;
+
+        // the limit could be exceeded by concurrent calls of new registries, but only by the count of threads
+        return dnCaches.computeIfAbsent(key, r -> new MappingCache<>(maxSize));
+    }
+
+    native CertificateResponse mapCertificate(byte[] certificate);
+
+    native MapperResponse mapDN(String distinguishedName, String registry);
+
+    native CertificateResponse mapCertificateDirect(ByteBuffer certificate, int offset, int length);
+
+    native MapperResponse mapDNDirect(
+        ByteBuffer distinguishedName, int distinguishedNameOffset, int distinguishedNameLength,
+        ByteBuffer registry, int registryOffset, int registryLength
+    );
+
+    native CertificateResponse[] mapCertificates(byte[][] certificates);
+
+    native MapperResponse[] mapDNs(String[] distinguishedNames, String registry);
+
+    /**
+     * Copies counters and latency histograms of SAF calls (see {@link org.zowe.commons.zos.NativeMetrics}).
+     *
+     * @param target array for the values, it could be null to get the required length
+     * @return number of values, if it is bigger than length of target nothing is copied
+     */
+    public static native int readNativeMetrics(long[] target);
+
+    /**
+     * Reads serial number, issuer, subject, validity and SHA-256 fingerprint of the certificate natively. Only these
+     * fields are read from DER encoding, no {@link java.security.cert.X509Certificate} is created.
+     *
+     * @param certificate DER encoded X.509 certificate
+     * @return basic fields of the certificate
+     * @throws IllegalArgumentException if the certificate is not valid
+     */
+    public native CertificateInfo getCertificateInfo(byte[] certificate);
+
+    /**
+     * Key of certificate in the cache (SHA-256 digest of certificate)
+     */
+    @RequiredArgsConstructor
+    @EqualsAndHashCode
+    private static final class CertificateKey {
+
+        private final byte[] digest;
+
+    }
 
-    public native MapperResponse getUserIDForDN(String distinguishedName, String registry);
 }
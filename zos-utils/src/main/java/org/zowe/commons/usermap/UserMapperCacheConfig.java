@@ -0,0 +1,51 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.usermap;
+
+import lombok.Builder;
+import lombok.Value;
+
+import java.time.Duration;
+
+/**
+ * Configuration of cache in {@link UserMapper}
+ */
+@Value
+@Builder
+public class UserMapperCacheConfig {
+
+    /**
+     * Maximal count of cached results
+     */
+    @Builder.Default
+    int maxSize = 1000;
+
+    /**
+     * Time to live of successful mapping
+     */
+    @Builder.Default
+    Duration ttl = Duration.ofMinutes(5);
+
+    /**
+     * Time to live of identity which is not mapped to any user, zero disables negative caching. Other failures are not
+     * cached.
+     */
+    @Builder.Default
+    Duration negativeTtl = Duration.ofMinutes(1);
+
+    /**
+     * Maximal count of registries with cached results of distinguished name mapping. Names in other registries are
+     * mapped without cache, so registries sent by clients cannot allocate unbounded number of partitions.
+     */
+    @Builder.Default
+    int maxRegistries = 16;
+
+}
@@ -0,0 +1,123 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.x509;
+
+import lombok.EqualsAndHashCode;
+
+import javax.security.auth.x500.X500Principal;
+import java.math.BigInteger;
+import java.time.Instant;
+
+/**
+ * Basic fields of X.509 certificate read natively from DER encoding (see
+ * {@link org.zowe.commons.attls.AttlsContext#getCertificateInfo()} and
+ * {@link org.zowe.commons.usermap.UserMapper#getCertificateInfo(byte[])}). Names are kept in DER encoding, Java objects
+ * are created only by getters.
+ */
+@EqualsAndHashCode
+public class CertificateInfo {
+
+    private static final char[] HEX = "0123456789ABCDEF".toCharArray();
+
+    private final byte[] serialNumber;
+    private final byte[] issuer;
+    private final byte[] subject;
+    private final long notBefore;
+    private final long notAfter;
+    private final byte[] fingerprint;
+
+    /**
+     * Create info of certificate (it is called by native code)
+     * @param serialNumber content of serial number (two's-complement, big endian)
+     * @param issuer DER encoding of issuer name
+     * @param subject DER encoding of subject name
+     * @param notBefore start of validity in milliseconds since epoch
+     * @param notAfter end of validity in milliseconds since epoch
+     * @param fingerprint SHA-256 digest of whole certificate
+     */
+    public CertificateInfo(byte[] serialNumber, byte[] issuer, byte[] subject, long notBefore, long notAfter, byte[] fingerprint) {
+        this.serialNumber = serialNumber;
+        this.issuer = issuer;
+        this.subject = subject;
+        this.notBefore = notBefore;
+        this.notAfter = notAfter;
+        this.fingerprint = fingerprint;
+    }
+
+    public BigInteger getSerialNumber() {
+        return new BigInteger(serialNumber);
+    }
+
+    public X500Principal getIssuerPrincipal() {
+        return new X500Principal(issuer);
+    }
+
+    public X500Principal getSubjectPrincipal() {
+        return new X500Principal(subject);
+    }
+
+    /**
+     * @return issuer name in format of RFC 2253
+     */
+    public String getIssuerDN() {
+        return getIssuerPrincipal().getName();
+    }
+
+    /**
+     * @return subject name in format of RFC 2253
+     */
+    public String getSubjectDN() {
+        return getSubjectPrincipal().getName();
+    }
+
+    public Instant getNotBefore() {
+        return Instant.ofEpochMilli(notBefore);
+    }
+
+    public Instant getNotAfter() {
+        return Instant.ofEpochMilli(notAfter);
+    }
+
+    /**
+     * @param time moment to verify
+     * @return true if the certificate is valid at the moment
+     */
+    public boolean isValidAt(Instant time) {
+        long millis = time.toEpochMilli();
+        return (millis >= notBefore) && (millis <= notAfter);
+    }
+
+    /**
+     * @return SHA-256 digest of whole certificate
+     */
+    public byte[] getFingerprint() {
+        return fingerprint.clone();
+    }
+
+    /**
+     * @return SHA-256 digest of whole certificate as hexadecimal string (upper case, without separators)
+     */
+    public String getFingerprintHex() {
+        char[] out = new char[fingerprint.length * 2];
+        for (int i = 0; i < fingerprint.length; i++) {
+            out[i * 2] = HEX[(fingerprint[i] >> 4) & 0xF];
+            out[i * 2 + 1] = HEX[fingerprint[i] & 0xF];
+        }
+        return new String(out);
+    }
+
+    @Override
+    public String toString() {
+        return "CertificateInfo(subject=" + getSubjectDN() + ", issuer=" + getIssuerDN() + ", serialNumber="
+            + getSerialNumber().toString(16) + ", notBefore=" + getNotBefore() + ", notAfter=" + getNotAfter()
+            + ", fingerprint=" + getFingerprintHex() + ")";
+    }
+
+}
@@ -0,0 +1,45 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.zos;
+
+import lombok.experimental.UtilityClass;
+
+/**
+ * Loads native libraries of this module. The libraries are loaded on z/OS, or on other platforms if the simulator
+ * is enabled by system property {@value #SIMULATOR_PROPERTY} (the libraries are built by task linuxbuild and they
+ * have to be on java.library.path).
+ */
+@UtilityClass
+public class NativeLibraryLoader {
+
+    public static final String SIMULATOR_PROPERTY = "org.zowe.commons.native.simulator";
+
+    public static boolean isZos() {
+        return "z/os".equalsIgnoreCase(System.getProperty("os.name"));
+    }
+
+    public static boolean isSimulator() {
+        return Boolean.getBoolean(SIMULATOR_PROPERTY);
+    }
+
+    /**
+     * Loads the library if native calls are available on this platform
+     * @param name name of library (without prefix lib and suffix .so)
+     * @return true if library was loaded, otherwise false
+     */
+    public static boolean load(String name) {
+        if (isZos() || isSimulator()) {
+            System.loadLibrary(name);
+            return true;
+        }
+        return false;
+    }
+
+}
@@ -0,0 +1,159 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.zos;
+
+import lombok.Getter;
+import lombok.RequiredArgsConstructor;
+import org.zowe.commons.attls.AttlsContext;
+import org.zowe.commons.usermap.UserMapper;
+
+import javax.management.JMException;
+import javax.management.MBeanServer;
+import javax.management.ObjectName;
+import java.lang.management.ManagementFactory;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.function.ToDoubleFunction;
+import java.util.function.ToIntFunction;
+import java.util.function.ToLongFunction;
+
+/**
+ * Counters and latency histograms of native calls, kept by the native libraries:
+ * <ul>
+ *     <li>zowe-attls - ioctl calls by type of request (query, query with certificate and each command)</li>
+ *     <li>zowe-usermap - SAF calls (mapping of certificate and distinguished name)</li>
+ * </ul>
+ * Errors are counted by errno and errno2 (RACF return and reason code for mapping of distinguished name). Recording
+ * is lock-free and always on.
+ *
+ * To publish metrics over JMX call {@link #register()}, ie. {@code NativeMetrics.attls().register()}.
+ */
+@RequiredArgsConstructor
+public class NativeMetrics implements NativeMetricsMXBean {
+
+    public static final String OBJECT_NAME_PREFIX = "org.zowe.commons:type=NativeMetrics,library=";
+
+    /**
+     * Names of operations of zowe-attls in the same order as in AttlsContext.c
+     */
+    static final String[] ATTLS_OPERATIONS = {
+        "query", "queryCertificate", "initConnection", "resetSession", "resetCipher", "stopConnection",
+        "allowHandShakeTimeout", "mapCertificate"
+    };
+
+    /**
+     * Names of operations of zowe-usermap in the same order as in javaUsermap.c
+     */
+    static final String[] USERMAP_OPERATIONS = {"certificate", "dn"};
+
+    private static final double NANOS_PER_MICRO = 1000.0;
+
+    @Getter
+    private final String library;
+    private final String[] operations;
+    private final ToIntFunction<long[]> reader;
+
+    public static NativeMetrics attls() {
+        return new NativeMetrics(AttlsContext.ATTLS_LIBRARY_NAME, ATTLS_OPERATIONS, AttlsContext::readNativeMetrics);
+    }
+
+    public static NativeMetrics usermap() {
+        return new NativeMetrics(UserMapper.USERMAP_LIBRARY_NAME, USERMAP_OPERATIONS, UserMapper::readNativeMetrics);
+    }
+
+    /**
+     * @return current values of metrics
+     */
+    public NativeMetricsSnapshot getSnapshot() {
+        long[] values = new long[reader.applyAsInt(null)];
+        int length;
+        while ((length = reader.applyAsInt(values)) > values.length) {
+            values = new long[length];
+        }
+        return NativeMetricsSnapshot.parse(operations, values);
+    }
+
+    /**
+     * Registers this instance into platform MBean server
+     *
+     * @return name of registered MBean
+     * @throws JMException if MBean cannot be registered (ie. it is already registered)
+     */
+    public ObjectName register() throws JMException {
+        MBeanServer server = ManagementFactory.getPlatformMBeanServer();
+        ObjectName name = new ObjectName(OBJECT_NAME_PREFIX + library);
+        server.registerMBean(this, name);
+        return name;
+    }
+
+    private Map<String, Long> longs(ToLongFunction<OperationMetrics> value) {
+        Map<String, Long> out = new LinkedHashMap<>();
+        for (OperationMetrics operation : getSnapshot().getOperations()) {
+            out.put(operation.getName(), value.applyAsLong(operation));
+        }
+        return out;
+    }
+
+    private Map<String, Double> micros(ToDoubleFunction<OperationMetrics> nanos) {
+        Map<String, Double> out = new LinkedHashMap<>();
+        for (OperationMetrics operation : getSnapshot().getOperations()) {
+            out.put(operation.getName(), nanos.applyAsDouble(operation) / NANOS_PER_MICRO);
+        }
+        return out;
+    }
+
+    @Override
+    public Map<String, Long> getCounts() {
+        return longs(OperationMetrics::getCount);
+    }
+
+    @Override
+    public Map<String, Long> getErrors() {
+        return longs(OperationMetrics::getErrors);
+    }
+
+    @Override
+    public Map<String, Double> getMeanMicros() {
+        return micros(OperationMetrics::getMeanNanos);
+    }
+
+    @Override
+    public Map<String, Double> getMedianMicros() {
+        return micros(operation -> operation.getPercentileNanos(50));
+    }
+
+    @Override
+    public Map<String, Double> getP99Micros() {
+        return micros(operation -> operation.getPercentileNanos(99));
+    }
+
+    @Override
+    public Map<String, Double> getMaxMicros() {
+        return micros(OperationMetrics::getMaxNanos);
+    }
+
+    @Override
+    public Map<Integer, Long> getErrnoCounts() {
+        return getSnapshot().getErrnoCounts();
+    }
+
+    @Override
+    public Map<String, Long> getErrno2Counts() {
+        Map<String, Long> out = new LinkedHashMap<>();
+        getSnapshot().getErrno2Counts().forEach((code, count) -> out.put(Integer.toHexString(code), count));
+        return out;
+    }
+
+    @Override
+    public long getCodesOverflow() {
+        return getSnapshot().getCodesOverflow();
+    }
+
+}
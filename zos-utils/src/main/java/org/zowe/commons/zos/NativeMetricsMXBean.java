@@ -0,0 +1,44 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.zos;
+
+import java.util.Map;
+
+/**
+ * JMX view of native metrics. Each attribute reads a fresh snapshot by one native call, which copies the counters
+ * without any lock, so reading does not slow down the measured calls. Maps are keyed by name of operation.
+ */
+public interface NativeMetricsMXBean {
+
+    Map<String, Long> getCounts();
+
+    Map<String, Long> getErrors();
+
+    Map<String, Double> getMeanMicros();
+
+    Map<String, Double> getMedianMicros();
+
+    Map<String, Double> getP99Micros();
+
+    Map<String, Double> getMaxMicros();
+
+    /**
+     * @return counts of failed calls by errno
+     */
+    Map<Integer, Long> getErrnoCounts();
+
+    /**
+     * @return counts of failed calls by errno2 (reason code in hexadecimal)
+     */
+    Map<String, Long> getErrno2Counts();
+
+    long getCodesOverflow();
+
+}
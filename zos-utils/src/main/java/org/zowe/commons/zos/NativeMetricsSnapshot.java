@@ -0,0 +1,91 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.zos;
+
+import lombok.Value;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Snapshot of native metrics of one library: metrics of each operation and counts of failed calls by errno and
+ * errno2. Counts of codes which did not fit into the native table are summed in codesOverflow.
+ */
+@Value
+public class NativeMetricsSnapshot {
+
+    private static final int VERSION = 1;
+    private static final int HEADER_LENGTH = 5;
+    private static final int OPERATION_HEADER_LENGTH = 4;
+
+    List<OperationMetrics> operations;
+    Map<Integer, Long> errnoCounts;
+    Map<Integer, Long> errno2Counts;
+    long codesOverflow;
+
+    /**
+     * Decodes values copied by the native library (see metrics_copy in nativeMetrics.c)
+     *
+     * @param names names of operations in the order of native library
+     * @param values values copied by native library
+     * @return decoded snapshot
+     */
+    public static NativeMetricsSnapshot parse(String[] names, long[] values) {
+        if (values.length < HEADER_LENGTH || values[0] != VERSION) {
+            throw new IllegalArgumentException("Unsupported format of native metrics");
+        }
+        int operationCount = (int) values[1];
+        int bucketCount = (int) values[2];
+        int codeSlots = (int) values[3];
+
+        int position = HEADER_LENGTH;
+        List<OperationMetrics> operations = new ArrayList<>(operationCount);
+        for (int i = 0; i < operationCount; i++) {
+            long[] buckets = new long[bucketCount];
+            System.arraycopy(values, position + OPERATION_HEADER_LENGTH, buckets, 0, bucketCount);
+            String name = i < names.length ? names[i] : String.valueOf(i);
+            operations.add(new OperationMetrics(
+                name, values[position], values[position + 1], values[position + 2], values[position + 3], buckets
+            ));
+            position += OPERATION_HEADER_LENGTH + bucketCount;
+        }
+
+        Map<Integer, Long> errnoCounts = parseCodes(values, position, codeSlots);
+        Map<Integer, Long> errno2Counts = parseCodes(values, position + 2 * codeSlots, codeSlots);
+
+        return new NativeMetricsSnapshot(
+            Collections.unmodifiableList(operations), errnoCounts, errno2Counts, values[4]
+        );
+    }
+
+    private static Map<Integer, Long> parseCodes(long[] values, int position, int codeSlots) {
+        Map<Integer, Long> codes = new LinkedHashMap<>();
+        for (int i = 0; i < codeSlots; i++) {
+            long key = values[position + 2 * i];
+            if (key != 0) codes.put((int) key, values[position + 2 * i + 1]);
+        }
+        return Collections.unmodifiableMap(codes);
+    }
+
+    /**
+     * @param name name of operation
+     * @return metrics of the operation or null if there is no such operation
+     */
+    public OperationMetrics getOperation(String name) {
+        for (OperationMetrics operation : operations) {
+            if (operation.getName().equals(name)) return operation;
+        }
+        return null;
+    }
+
+}
@@ -0,0 +1,36 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.zos;
+
+import lombok.experimental.UtilityClass;
+
+/**
+ * Runtime configuration of native simulator (the Linux build of native libraries, see zossrc/linux/simulator.h). The
+ * initial values are read from the file set by environment variable ZOWE_NATIVE_SIMULATOR. Keys are described in
+ * attlsBackendSim.c and usermapBackendSim.c.
+ *
+ * The methods are available only if the simulator libraries are loaded (see {@link NativeLibraryLoader}). The
+ * configuration is shared by all threads, it should be changed before the measured or tested code runs.
+ */
+@UtilityClass
+public class NativeSimulator {
+
+    /**
+     * Sets option of AT-TLS simulator, ie. configureAttls("statConn", "3"). The library zowe-attls must be loaded.
+     */
+    public static native void configureAttls(String key, String value);
+
+    /**
+     * Sets option of user mapping simulator, ie. configureUsermap("userId", "USER1"). The library zowe-usermap must
+     * be loaded.
+     */
+    public static native void configureUsermap(String key, String value);
+
+}
@@ -0,0 +1,63 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.zos;
+
+import lombok.Value;
+
+/**
+ * Snapshot of counters and latency histogram of one native operation. The histogram is log-linear (see
+ * nativeMetrics.h), so percentiles are upper bounds of buckets with a relative error up to 25 %.
+ */
+@Value
+public class OperationMetrics {
+
+    String name;
+    long count;
+    long errors;
+    long totalNanos;
+    long maxNanos;
+    long[] buckets;
+
+    /**
+     * @param index index of bucket
+     * @return the smallest duration (in nanoseconds) counted in the bucket
+     */
+    public static long bucketLowerBound(int index) {
+        if (index < 4) return index;
+        int bit = index / 4 + 1;
+        return (4L + index % 4) << (bit - 2);
+    }
+
+    public double getMeanNanos() {
+        return count == 0 ? 0 : (double) totalNanos / count;
+    }
+
+    /**
+     * @param percentile value between 0 and 100
+     * @return duration (in nanoseconds) which is not exceeded by the percentile of calls
+     */
+    public long getPercentileNanos(double percentile) {
+        long total = 0;
+        for (long bucket : buckets) total += bucket;
+        if (total == 0) return 0;
+
+        long rank = Math.max(1, (long) Math.ceil(total * percentile / 100));
+        long cumulative = 0;
+        for (int i = 0; i < buckets.length; i++) {
+            cumulative += buckets[i];
+            if (cumulative >= rank) {
+                long upper = (i == buckets.length - 1) ? maxNanos : bucketLowerBound(i + 1) - 1;
+                return Math.min(upper, maxNanos);
+            }
+        }
+        return maxNanos;
+    }
+
+}
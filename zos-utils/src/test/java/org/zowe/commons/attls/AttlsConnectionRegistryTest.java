@@ -0,0 +1,168 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import org.junit.jupiter.api.Test;
+import org.springframework.test.util.ReflectionTestUtils;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.mockito.Mockito.*;
+
+public class AttlsConnectionRegistryTest {
+
+    @Test
+    public void testAttachAndDetach() throws ContextIsNotInitializedException {
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry(16, true, false);
+        AttlsConnectionRegistry.Registration registration = registry.attach(5);
+
+        AttlsContext context = registry.require(5);
+        assertSame(registration.getContext(), context);
+        assertEquals(5, ReflectionTestUtils.getField(context, "id"));
+        assertTrue((Boolean) ReflectionTestUtils.getField(context, "alwaysLoadCertificate"));
+        assertNull(registry.get(6));
+        assertEquals(1, registry.size());
+
+        assertTrue(registry.detach(5, context));
+        assertNull(registry.get(5));
+        assertThrows(ContextIsNotInitializedException.class, () -> registry.require(5));
+        assertEquals(0, registry.size());
+    }
+
+    @Test
+    public void testClose_cleansDetachedContext() {
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry();
+        AttlsContext context = mock(AttlsContext.class);
+        AttlsConnectionRegistry.Registration registration = registry.attach(5, context);
+
+        registration.close();
+        assertNull(registry.get(5));
+        verify(context).clean();
+
+        // the second close does not clean the context again
+        registration.close();
+        verify(context, times(1)).clean();
+    }
+
+    @Test
+    public void testLateCloseDoesNotDetachNewConnection() {
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry();
+        AttlsContext oldContext = mock(AttlsContext.class);
+        AttlsConnectionRegistry.Registration oldConnection = registry.attach(7, oldContext);
+        AttlsConnectionRegistry.Registration newConnection = registry.attach(7);
+
+        oldConnection.close();
+        verify(oldContext, never()).clean();
+        assertSame(newConnection.getContext(), registry.get(7));
+        assertSame(newConnection.getContext(), registry.detach(7));
+        assertNull(registry.detach(7));
+    }
+
+    @Test
+    public void testCollisions() {
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry(5, false, false);
+        AttlsContext[] contexts = new AttlsContext[8];
+        for (int fd = 0; fd < 8; fd++) {
+            contexts[fd] = new AttlsContext(fd, false);
+            registry.attach(fd, contexts[fd]);
+        }
+        for (int fd = 0; fd < 8; fd++) {
+            assertSame(contexts[fd], registry.get(fd));
+        }
+        assertThrows(IllegalStateException.class, () -> registry.attach(8));
+
+        // detached file descriptors keep their slots
+        assertTrue(registry.detach(3, contexts[3]));
+        assertNull(registry.get(3));
+        assertNotNull(registry.attach(3));
+    }
+
+    @Test
+    public void testPrefetch() {
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry();
+        registry.setPrefetch(true);
+        AttlsConnectionRegistry.Registration registration = registry.attach(9);
+
+        CompletableFuture<?> future = (CompletableFuture<?>) ReflectionTestUtils.getField(registration.getContext(), "queryFuture");
+        assertNotNull(future);
+        assertSame(registration.getContext(), registry.getAsync(9).join());
+        assertTrue(future.isDone());
+    }
+
+    @Test
+    public void testGetAsync() {
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry();
+        AttlsContext context = new AttlsContext(4, false);
+        CompletableFuture<AttlsContext> pending = new CompletableFuture<>();
+        ReflectionTestUtils.setField(context, "lastFuture", pending);
+        registry.attach(4, context);
+
+        // lookup does not wait for the pending call
+        assertSame(context, registry.get(4));
+        CompletableFuture<AttlsContext> future = registry.getAsync(4);
+        assertFalse(future.isDone());
+        pending.completeExceptionally(new IllegalStateException());
+        assertSame(context, future.join());
+
+        assertNull(registry.getAsync(5).join());
+    }
+
+    @Test
+    public void testInvalidArguments() {
+        assertThrows(IllegalArgumentException.class, () -> new AttlsConnectionRegistry(0, false, false));
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry();
+        assertThrows(IllegalArgumentException.class, () -> registry.attach(-1));
+        assertThrows(IllegalArgumentException.class, () -> registry.attach(1, null));
+        assertNull(registry.get(-1));
+        assertFalse(registry.detach(-1, null));
+    }
+
+    @Test
+    public void testConcurrentAccess() throws Exception {
+        AttlsConnectionRegistry registry = new AttlsConnectionRegistry(1024, false, false);
+        ExecutorService executor = Executors.newFixedThreadPool(8);
+        CountDownLatch start = new CountDownLatch(1);
+        try {
+            List<Future<Boolean>> results = new ArrayList<>();
+            for (int t = 0; t < 8; t++) {
+                int base = t * 100;
+                // closing of registration cleans the context, the native library is not loaded in unit tests
+                AttlsContext context = mock(AttlsContext.class, withSettings().stubOnly());
+                results.add(executor.submit(() -> {
+                    start.await();
+                    for (int round = 0; round < 1000; round++) {
+                        for (int fd = base; fd < base + 100; fd++) {
+                            AttlsConnectionRegistry.Registration registration = registry.attach(fd, context);
+                            if (registry.get(fd) != registration.getContext()) return false;
+                            registration.close();
+                        }
+                    }
+                    return true;
+                }));
+            }
+            start.countDown();
+            for (Future<Boolean> result : results) {
+                assertTrue(result.get(30, TimeUnit.SECONDS));
+            }
+            assertEquals(0, registry.size());
+        } finally {
+            executor.shutdownNow();
+        }
+    }
+
+}
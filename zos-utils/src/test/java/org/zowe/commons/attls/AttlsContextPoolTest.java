@@ -0,0 +1,63 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import org.junit.jupiter.api.Test;
+import org.springframework.test.util.ReflectionTestUtils;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.mockito.Mockito.*;
+
+public class AttlsContextPoolTest {
+
+    @Test
+    public void testAcquire_whenPoolIsEmpty() {
+        AttlsContextPool pool = new AttlsContextPool(4, true, true);
+        AttlsContext context = pool.acquire(12);
+        assertEquals(12, ReflectionTestUtils.getField(context, "id"));
+        assertTrue((Boolean) ReflectionTestUtils.getField(context, "alwaysLoadCertificate"));
+        assertTrue((Boolean) ReflectionTestUtils.getField(context, "directMemory"));
+    }
+
+    @Test
+    public void testReleaseAndAcquire() {
+        AttlsContextPool pool = new AttlsContextPool(4, false, false);
+        AttlsContext context = mock(AttlsContext.class);
+
+        assertTrue(pool.release(context));
+        // data of the connection are zeroed on release, not on the next acquire
+        verify(context).reset(-1);
+        assertEquals(1, pool.size());
+
+        assertSame(context, pool.acquire(33));
+        verify(context).setId(33);
+        verify(context, times(1)).reset(anyInt());
+        assertEquals(0, pool.size());
+        assertNotSame(context, pool.acquire(34));
+    }
+
+    @Test
+    public void testRelease_whenPoolIsFull() {
+        AttlsContextPool pool = new AttlsContextPool(2, false, false);
+        assertTrue(pool.release(mock(AttlsContext.class)));
+        assertTrue(pool.release(mock(AttlsContext.class)));
+        AttlsContext dropped = mock(AttlsContext.class);
+        assertFalse(pool.release(dropped));
+        verify(dropped).reset(-1);
+        assertFalse(pool.release(null));
+        assertEquals(2, pool.size());
+    }
+
+    @Test
+    public void testInvalidCapacity() {
+        assertThrows(IllegalArgumentException.class, () -> new AttlsContextPool(0, false, false));
+    }
+
+}
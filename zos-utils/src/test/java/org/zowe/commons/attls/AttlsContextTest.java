@@ -0,0 +1,242 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+import org.springframework.test.util.ReflectionTestUtils;
+
+import java.nio.ByteBuffer;
+import java.nio.ReadOnlyBufferException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.RejectedExecutionException;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.mockito.Mockito.*;
+
+public class AttlsContextTest {
+
+    private AttlsContext attlsContext;
+    private List<Runnable> tasks;
+
+    @BeforeEach
+    public void setUp() {
+        attlsContext = spy(new AttlsContext(10, false));
+        tasks = new ArrayList<>();
+    }
+
+    private void runTasks() {
+        tasks.forEach(Runnable::run);
+        tasks.clear();
+    }
+
+    @Test
+    public void testQueryAsync_coalesceConcurrentCalls() throws Exception {
+        doReturn(1L).when(attlsContext).getPackedStatus();
+
+        CompletableFuture<AttlsContext> first = attlsContext.queryAsync(tasks::add);
+        CompletableFuture<AttlsContext> second = attlsContext.queryAsync(tasks::add);
+        assertSame(first, second);
+        assertEquals(1, tasks.size());
+        assertFalse(first.isDone());
+
+        runTasks();
+        assertSame(attlsContext, first.get());
+        verify(attlsContext, times(1)).getPackedStatus();
+
+        // finished call is returned until the context is cleaned
+        assertSame(first, attlsContext.queryAsync(tasks::add));
+        assertTrue(tasks.isEmpty());
+
+        ReflectionTestUtils.setField(attlsContext, "queryFuture", null);
+        assertNotSame(first, attlsContext.queryAsync(tasks::add));
+        assertEquals(1, tasks.size());
+    }
+
+    @Test
+    public void testQueryAsync_whenIoctlFails() throws Exception {
+        IoctlCallException exception = new IoctlCallException(1, 2, 3);
+        doThrow(exception).when(attlsContext).getPackedStatus();
+
+        CompletableFuture<AttlsContext> future = attlsContext.queryAsync(tasks::add);
+        runTasks();
+        ExecutionException ee = assertThrows(ExecutionException.class, future::get);
+        assertSame(exception, ee.getCause());
+
+        // failed call is not cached, the next one calls ioctl again
+        doReturn(1L).when(attlsContext).getPackedStatus();
+        CompletableFuture<AttlsContext> retry = attlsContext.queryAsync(tasks::add);
+        assertNotSame(future, retry);
+        runTasks();
+        assertSame(attlsContext, retry.get());
+    }
+
+    @Test
+    public void testGetCertificateAsync() throws Exception {
+        byte[] certificate = new byte[] {1, 2, 3};
+        doReturn(certificate).when(attlsContext).getCertificate();
+
+        CompletableFuture<byte[]> future = attlsContext.getCertificateAsync(tasks::add);
+        assertSame(future, attlsContext.getCertificateAsync(tasks::add));
+        runTasks();
+        assertSame(certificate, future.get());
+        verify(attlsContext, times(1)).getCertificate();
+        verify(attlsContext, never()).getPackedStatus();
+    }
+
+    @Test
+    public void testAsync_callsOfContextDoNotOverlap() throws Exception {
+        byte[] certificate = new byte[] {1, 2, 3};
+        doReturn(1L).when(attlsContext).getPackedStatus();
+        doReturn(certificate).when(attlsContext).getCertificate();
+
+        CompletableFuture<AttlsContext> query = attlsContext.queryAsync(tasks::add);
+        CompletableFuture<byte[]> certificateFuture = attlsContext.getCertificateAsync(tasks::add);
+        // the certificate is submitted only when the query is done
+        assertEquals(1, tasks.size());
+
+        tasks.remove(0).run();
+        assertTrue(query.isDone());
+        assertFalse(certificateFuture.isDone());
+        assertEquals(1, tasks.size());
+
+        tasks.remove(0).run();
+        assertSame(certificate, certificateFuture.get());
+    }
+
+    @Test
+    public void testAwaitAsync() throws Exception {
+        doReturn(1L).when(attlsContext).getPackedStatus();
+        attlsContext.awaitAsync();
+
+        CompletableFuture<AttlsContext> future = attlsContext.queryAsync(tasks::add);
+        Thread thread = new Thread(() -> {
+            try {
+                Thread.sleep(50);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+            runTasks();
+        });
+        thread.start();
+        attlsContext.awaitAsync();
+        assertTrue(future.isDone());
+        thread.join();
+    }
+
+    @Test
+    public void testCommandAndQuery_awaitsAsync() throws Exception {
+        doReturn(1L).when(attlsContext).getPackedStatus();
+
+        CompletableFuture<AttlsContext> future = attlsContext.queryAsync(tasks::add);
+        Thread thread = new Thread(() -> {
+            try {
+                Thread.sleep(50);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+            runTasks();
+        });
+        thread.start();
+        // the native library is not loaded in unit tests, the command is reached only after the pending query
+        assertThrows(UnsatisfiedLinkError.class, () -> attlsContext.initConnectionAndQuery(false));
+        assertTrue(future.isDone());
+        thread.join();
+    }
+
+    @Test
+    public void testAsync_whenExecutorRejects() throws Exception {
+        CompletableFuture<AttlsContext> future = attlsContext.queryAsync(task -> {
+            throw new RejectedExecutionException();
+        });
+        ExecutionException ee = assertThrows(ExecutionException.class, future::get);
+        assertTrue(ee.getCause() instanceof RejectedExecutionException);
+
+        // rejected call is not cached
+        assertNotSame(future, attlsContext.queryAsync(tasks::add));
+    }
+
+    @Test
+    public void testGetCertificate_intoArray() throws Exception {
+        byte[] dst = new byte[10];
+        doReturn(4).when(attlsContext).copyCertificate(dst, 3, 7);
+
+        assertEquals(4, attlsContext.getCertificate(dst, 3));
+        assertEquals(0, attlsContext.getCertificate(dst, 10));
+        verify(attlsContext).copyCertificate(dst, 10, 0);
+        assertThrows(IndexOutOfBoundsException.class, () -> attlsContext.getCertificate(dst, 11));
+        assertThrows(IndexOutOfBoundsException.class, () -> attlsContext.getCertificate(dst, -1));
+    }
+
+    @Test
+    public void testGetCertificate_intoHeapBuffer() throws Exception {
+        byte[] array = new byte[20];
+        ByteBuffer dst = ByteBuffer.wrap(array, 2, 18).slice();
+        dst.position(3);
+        doReturn(5).when(attlsContext).copyCertificate(array, 5, 12);
+
+        assertEquals(5, attlsContext.getCertificate(dst));
+        assertEquals(8, dst.position());
+        verify(attlsContext, never()).copyCertificateDirect(any(), anyInt(), anyInt());
+    }
+
+    @Test
+    public void testGetCertificate_intoDirectBuffer() throws Exception {
+        ByteBuffer dst = ByteBuffer.allocateDirect(16);
+        dst.position(4);
+        doReturn(20).when(attlsContext).copyCertificateDirect(dst, 4, 12);
+
+        // certificate does not fit, nothing is copied and the position is kept
+        assertEquals(20, attlsContext.getCertificate(dst));
+        assertEquals(4, dst.position());
+    }
+
+    @Test
+    public void testGetCertificate_readOnlyBuffer() {
+        ByteBuffer dst = ByteBuffer.allocate(16).asReadOnlyBuffer();
+        assertThrows(ReadOnlyBufferException.class, () -> attlsContext.getCertificate(dst));
+    }
+
+    @Test
+    public void testCacheCertificate() {
+        assertTrue(attlsContext.isCacheCertificate());
+        attlsContext.setCacheCertificate(false);
+        assertFalse(attlsContext.isCacheCertificate());
+    }
+
+    @Test
+    public void testTolerateUnknownValues() {
+        boolean original = AttlsContext.isTolerateUnknownValues();
+        try {
+            AttlsContext.setTolerateUnknownValues(true);
+            assertTrue(AttlsContext.isTolerateUnknownValues());
+            AttlsContext.setTolerateUnknownValues(false);
+            assertFalse(AttlsContext.isTolerateUnknownValues());
+        } finally {
+            AttlsContext.setTolerateUnknownValues(original);
+        }
+    }
+
+    @Test
+    public void testUnknownEnumValueException() {
+        UnknownEnumValueException statConn = new UnknownEnumValueException(StatConn.class, (byte) 9);
+        assertSame(StatConn.class, statConn.getEnumClazz());
+        assertEquals(9, statConn.getValue());
+        assertEquals(0, statConn.getValue2());
+
+        UnknownEnumValueException protocol = new UnknownEnumValueException(Protocol.class, (byte) 3, (byte) 5);
+        assertEquals(3, protocol.getValue());
+        assertEquals(5, protocol.getValue2());
+    }
+
+}
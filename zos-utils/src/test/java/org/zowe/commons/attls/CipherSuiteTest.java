@@ -0,0 +1,61 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import org.junit.jupiter.api.Test;
+
+import java.util.HashSet;
+import java.util.Set;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertSame;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+import static org.zowe.commons.attls.CipherSuite.*;
+
+public class CipherSuiteTest {
+
+    @Test
+    public void testValueOfCode() {
+        assertSame(TLS_RSA_WITH_AES_256_CBC_SHA, CipherSuite.valueOfCode("35"));
+        assertSame(TLS_RSA_WITH_AES_256_CBC_SHA, CipherSuite.valueOfCode("0035"));
+        assertSame(TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256, CipherSuite.valueOfCode("C02F"));
+        assertSame(TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256, CipherSuite.valueOfCode("c02f"));
+        assertSame(TLS_AES_256_GCM_SHA384, CipherSuite.valueOfCode("1302"));
+        assertNull(CipherSuite.valueOfCode("4X"));
+        assertNull(CipherSuite.valueOfCode("FFFF"));
+        assertNull(CipherSuite.valueOfCode(null));
+    }
+
+    @Test
+    public void testAttributes() {
+        assertEquals("TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384", TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384.getIanaName());
+        assertEquals(KeyExchange.ECDHE_ECDSA, TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384.getKeyExchange());
+        assertEquals(256, TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384.getStrength());
+        assertNull(TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384.getCode2());
+        assertEquals(112, TLS_RSA_WITH_3DES_EDE_CBC_SHA.getStrength());
+        assertEquals(0, TLS_RSA_WITH_NULL_SHA.getStrength());
+    }
+
+    @Test
+    public void testCodesAreUnique() {
+        Set<String> codes = new HashSet<>();
+        for (CipherSuite cipherSuite : values()) {
+            assertEquals(4, cipherSuite.getCode4().length());
+            assertTrue(codes.add(cipherSuite.getCode4()));
+            if (cipherSuite.getCode2() != null) {
+                assertEquals(2, cipherSuite.getCode2().length());
+                assertTrue(codes.add(cipherSuite.getCode2()));
+                assertTrue(cipherSuite.getCode4().endsWith(cipherSuite.getCode2()));
+            }
+        }
+    }
+
+}
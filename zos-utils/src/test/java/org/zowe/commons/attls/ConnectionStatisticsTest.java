@@ -0,0 +1,104 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class ConnectionStatisticsTest {
+
+    private static final int BYTE_SLOTS = 8;
+    private static final int PROTOCOL_SLOTS = 33;
+    private static final int CIPHER_SLOTS = 32;
+
+    /**
+     * Values in the same format as stats_copy in connectionStats.c: 10 connections, 8 of them TLS 1.3 with FIPS off,
+     * 2 connections without policy. Cipher 0x002F was removed, its slot stays with zero count.
+     */
+    private long[] values() {
+        long[] values = new long[6 + 3 * BYTE_SLOTS + PROTOCOL_SLOTS + 2 * CIPHER_SLOTS];
+        values[0] = 2;
+        values[1] = BYTE_SLOTS;
+        values[2] = PROTOCOL_SLOTS;
+        values[3] = CIPHER_SLOTS;
+        values[4] = 10;
+        values[5] = 3;
+
+        int statPolicy = 6;
+        values[statPolicy + 4] = 8;
+        values[statPolicy + 2] = 2;
+
+        int statConn = statPolicy + BYTE_SLOTS;
+        values[statConn + 3] = 8;
+        values[statConn + 1] = 1;
+        values[statConn + BYTE_SLOTS - 1] = 1;
+
+        int fips140 = statConn + BYTE_SLOTS;
+        values[fips140] = 10;
+
+        int protocol = fips140 + BYTE_SLOTS;
+        values[protocol] = 2;
+        values[protocol + 3 * 8 + 4] = 7;
+        values[protocol + 3 * 8 + 7] = 1;
+
+        int cipher = protocol + PROTOCOL_SLOTS;
+        values[cipher] = 0x1301 + 1;
+        values[cipher + 1] = 5;
+        values[cipher + 4] = 0xABCD + 1;
+        values[cipher + 5] = 3;
+        values[cipher + 8] = 0x002F + 1;
+        return values;
+    }
+
+    @Test
+    public void testParse() {
+        ConnectionStatistics statistics = ConnectionStatistics.parse(values());
+
+        assertEquals(10, statistics.getConnections());
+        assertEquals(3, statistics.getCiphersOverflow());
+        assertEquals(8L, statistics.getStatPolicies().get(StatPolicy.ENABLED));
+        assertEquals(2L, statistics.getStatPolicies().get(StatPolicy.NO_POLICY));
+        assertEquals(2, statistics.getStatPolicies().size());
+        assertEquals(1L, statistics.getStatConns().get(StatConn.UNRECOGNIZED));
+        assertEquals(10L, statistics.getFips140s().get(Fips140.FIPS140_OFF));
+
+        assertEquals(2L, statistics.getProtocols().get(Protocol.NON_SECURE));
+        assertEquals(7L, statistics.getProtocols().get(Protocol.TLS1_3));
+        // version 3.7 is not known
+        assertEquals(1L, statistics.getProtocols().get(Protocol.UNRECOGNIZED));
+
+        assertEquals(5L, statistics.getCiphers().get("1301"));
+        assertEquals(3L, statistics.getCiphers().get("ABCD"));
+        assertEquals(2, statistics.getCiphers().size());
+        assertEquals(1, statistics.getCipherSuites().size());
+        assertEquals(5L, statistics.getCipherSuites().get(CipherSuite.TLS_AES_128_GCM_SHA256));
+    }
+
+    @Test
+    public void testSecuredShare() {
+        ConnectionStatistics statistics = ConnectionStatistics.parse(values());
+        assertEquals(8, statistics.getSecured());
+        assertEquals(0.8, statistics.getSecuredShare(), 1e-9);
+
+        long[] empty = new long[values().length];
+        System.arraycopy(values(), 0, empty, 0, 4);
+        assertEquals(0, ConnectionStatistics.parse(empty).getSecuredShare());
+    }
+
+    @Test
+    public void testUnsupportedVersion() {
+        long[] values = values();
+        values[0] = 1;
+        assertThrows(IllegalArgumentException.class, () -> ConnectionStatistics.parse(values));
+        assertThrows(IllegalArgumentException.class, () -> ConnectionStatistics.parse(new long[3]));
+    }
+
+}
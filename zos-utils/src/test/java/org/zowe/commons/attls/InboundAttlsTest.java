@@ -16,9 +16,11 @@ import org.junit.jupiter.api.extension.ExtendWith;
 import org.mockito.Mock;
 import org.mockito.junit.jupiter.MockitoExtension;
 import org.springframework.test.util.ReflectionTestUtils;
+import org.zowe.commons.usermap.CertificateResponse;
 
 import java.lang.reflect.InvocationTargetException;
 import java.lang.reflect.Method;
+import java.util.concurrent.CompletableFuture;
 
 import static org.junit.jupiter.api.Assertions.*;
 import static org.mockito.Mockito.*;
@@ -55,11 +57,48 @@ public class InboundAttlsTest {
         assertTrue((Boolean) ReflectionTestUtils.getField(InboundAttls.get(), "alwaysLoadCertificate"));
     }
 
+    @Test
+    public void testInit_whenDirectMemoryIsTrue() throws ContextIsNotInitializedException {
+        InboundAttls.setDirectMemory(true);
+        try {
+            InboundAttls.init(321);
+            assertEquals(321, ReflectionTestUtils.getField(InboundAttls.get(), "id"));
+            assertTrue((Boolean) ReflectionTestUtils.getField(InboundAttls.get(), "directMemory"));
+        } finally {
+            InboundAttls.setDirectMemory(false);
+        }
+    }
+
     @Test
     public void testDispose() throws ContextIsNotInitializedException {
         assertNotNull(InboundAttls.get());
         InboundAttls.dispose();
         assertThrows(ContextIsNotInitializedException.class, InboundAttls::get);
+        // the connection is removed from statistics
+        verify(attlsContext).clean();
+
+        // without a context it does nothing
+        InboundAttls.dispose();
+        verify(attlsContext, times(1)).clean();
+    }
+
+    @Test
+    public void testPool() throws ContextIsNotInitializedException {
+        AttlsContextPool pool = new AttlsContextPool(1, false, false);
+        InboundAttls.setPool(pool);
+        try {
+            InboundAttls.dispose();
+            assertEquals(1, pool.size());
+            verify(attlsContext).reset(-1);
+            verify(attlsContext, never()).clean();
+
+            InboundAttls.init(456);
+            assertSame(attlsContext, InboundAttls.get());
+            assertEquals(0, pool.size());
+            verify(attlsContext).setId(456);
+        } finally {
+            InboundAttls.setPool(null);
+        }
     }
 
     private void testCommand(String name) {
@@ -171,6 +210,50 @@ public class InboundAttlsTest {
         testSameGetter("getNegotiatedCipher4", "ABCD", "", "QWER");
     }
 
+    @Test
+    public void testPackedStatus() {
+        testEqualsGetter("getPackedStatus", 0L, 0x0506020603030304L);
+    }
+
+    @Test
+    public void testMapCertificateToUserId() {
+        testSameGetter("mapCertificateToUserId", new CertificateResponse("USER", 0, 0, 0), new CertificateResponse("", -1, 139, 0x1234));
+    }
+
+    @Test
+    public void testQueryAsync() {
+        testSameGetter("queryAsync", new CompletableFuture<AttlsContext>(), CompletableFuture.completedFuture(attlsContext));
+    }
+
+    @Test
+    public void testCertificateAsync() {
+        testSameGetter("getCertificateAsync", new CompletableFuture<byte[]>(), CompletableFuture.completedFuture(new byte[] {1}));
+    }
+
+    @Test
+    public void testTryQuery() throws ContextIsNotInitializedException {
+        long[] status = new long[2];
+        doAnswer(invocation -> {
+            ((long[]) invocation.getArgument(0))[1] = 0x1234;
+            return 111;
+        }).when(attlsContext).tryQuery(status);
+
+        assertEquals(111, InboundAttls.tryQuery(status));
+        assertEquals(0x1234, status[1]);
+
+        InboundAttls.dispose();
+        assertThrows(ContextIsNotInitializedException.class, () -> InboundAttls.tryQuery(status));
+    }
+
+    @Test
+    public void testNegotiatedKeyShare() {
+        testSameGetter("getNegotiatedKeyShare", "001D", null, "0017");
+    }
+
+    @Test
+    public void testCipherSuite() {
+        testSameGetter("getCipherSuite", CipherSuite.TLS_AES_128_GCM_SHA256, CipherSuite.TLS_RSA_WITH_AES_256_CBC_SHA);
+    }
 
     @Test
     public void testCertificate() {
@@ -187,6 +270,29 @@ public class InboundAttlsTest {
         testCommand("resetCipher");
     }
 
+    @Test
+    public void testGetAsync() throws Exception {
+        CompletableFuture<AttlsContext> future = CompletableFuture.completedFuture(attlsContext);
+        doReturn(future).when(attlsContext).whenReady();
+        assertSame(future, InboundAttls.getAsync());
+        verify(attlsContext, never()).awaitAsync();
+
+        InboundAttls.dispose();
+        assertThrows(ContextIsNotInitializedException.class, InboundAttls::getAsync);
+    }
+
+    @Test
+    public void testResetAndQuery() throws Exception {
+        InboundAttls.resetSessionAndQuery(true);
+        verify(attlsContext).resetSessionAndQuery(true);
+        InboundAttls.resetCipherAndQuery(false);
+        verify(attlsContext).resetCipherAndQuery(false);
+
+        InboundAttls.dispose();
+        assertThrows(ContextIsNotInitializedException.class, () -> InboundAttls.resetSessionAndQuery(false));
+        assertThrows(ContextIsNotInitializedException.class, () -> InboundAttls.resetCipherAndQuery(false));
+    }
+
     @AfterEach
     public void tearDown() {
         attlsContexts.remove();
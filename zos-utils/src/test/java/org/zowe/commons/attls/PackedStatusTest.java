@@ -0,0 +1,55 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.attls;
+
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class PackedStatusTest {
+
+    private static final long STATUS = 0x0506020603030304L;
+
+    @Test
+    public void testGetBytes() {
+        assertEquals(4, PackedStatus.getStatPolicy(STATUS));
+        assertEquals(3, PackedStatus.getStatConn(STATUS));
+        assertEquals(3, PackedStatus.getProtocolVersion(STATUS));
+        assertEquals(3, PackedStatus.getProtocolMod(STATUS));
+        assertEquals(6, PackedStatus.getSecurityType(STATUS));
+        assertEquals(2, PackedStatus.getFips140(STATUS));
+        assertEquals(6, PackedStatus.getFlags(STATUS));
+        assertEquals(5, PackedStatus.getUserIdLength(STATUS));
+    }
+
+    @Test
+    public void testToEnums() {
+        assertSame(StatPolicy.ENABLED, PackedStatus.toStatPolicy(STATUS));
+        assertSame(StatConn.SECURE, PackedStatus.toStatConn(STATUS));
+        assertSame(Protocol.TLS1_2, PackedStatus.toProtocol(STATUS));
+        assertSame(SecurityType.TTLS_SEC_SRV_CA_SAFCHK, PackedStatus.toSecurityType(STATUS));
+        assertSame(Fips140.TTLS_FIPS140_LEVEL1, PackedStatus.toFips140(STATUS));
+    }
+
+    @Test
+    public void testFlags() {
+        assertTrue(PackedStatus.isSecure(STATUS));
+        assertTrue(PackedStatus.hasUserId(STATUS));
+
+        assertFalse(PackedStatus.isSecure(0x0101L));
+        assertFalse(PackedStatus.hasUserId(0x0101L));
+    }
+
+    @Test
+    public void testUserIdLengthIsUnsigned() {
+        assertEquals(255, PackedStatus.getUserIdLength(0xff00000000000000L));
+    }
+
+}
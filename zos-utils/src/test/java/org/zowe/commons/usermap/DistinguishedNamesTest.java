@@ -0,0 +1,69 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.usermap;
+
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNotEquals;
+import static org.junit.jupiter.api.Assertions.assertNull;
+
+public class DistinguishedNamesTest {
+
+    private static final String CANONICAL = "cn=john smith,ou=dept,o=org";
+
+    @Test
+    public void testCaseAndWhitespaces() {
+        assertEquals(CANONICAL, DistinguishedNames.canonicalize("CN=John  Smith, OU=Dept, O=Org"));
+        assertEquals(CANONICAL, DistinguishedNames.canonicalize(" cn = john smith ,ou=dept,o=org "));
+        assertEquals(CANONICAL, DistinguishedNames.canonicalize("CN=John\tSmith,OU=Dept,O=Org"));
+    }
+
+    @Test
+    public void testSemicolonSeparator() {
+        assertEquals(CANONICAL, DistinguishedNames.canonicalize("CN=John Smith;OU=Dept; O=Org"));
+    }
+
+    @Test
+    public void testEscapedAndQuotedValues() {
+        assertEquals("cn=a\\, b,o=x", DistinguishedNames.canonicalize("CN=A\\, B,O=X"));
+        assertEquals("cn=\"a,  b\",o=x", DistinguishedNames.canonicalize("CN=\"a,  b\"  ,O=x"));
+        assertEquals("cn=a\\ ,o=x", DistinguishedNames.canonicalize("CN=a\\ ,O=x"));
+    }
+
+    @Test
+    public void testCaseOfQuotedAndEscapedValues() {
+        assertEquals("cn=\"John Smith\",o=org", DistinguishedNames.canonicalize("CN=\"John Smith\",O=Org"));
+        assertEquals("cn=b+ou=\"Dept A\",o=x", DistinguishedNames.canonicalize("OU=\"Dept A\" + CN=B,O=X"));
+        assertEquals("cn=a\\Bc,o=x", DistinguishedNames.canonicalize("CN=A\\BC,O=X"));
+        assertNotEquals(
+            DistinguishedNames.canonicalize("CN=\"Smith\",O=x"), DistinguishedNames.canonicalize("CN=\"smith\",O=x")
+        );
+    }
+
+    @Test
+    public void testMultiValuedRdn() {
+        assertEquals("cn=a+ou=b,o=x", DistinguishedNames.canonicalize("OU=b + CN=a,O=x"));
+        assertEquals("cn=a+ou=b,o=x", DistinguishedNames.canonicalize("CN=a+OU=b,O=x"));
+    }
+
+    @Test
+    public void testRegistry() {
+        assertEquals("ldap://host:389", DistinguishedNames.canonicalizeRegistry(" LDAP://Host:389 "));
+    }
+
+    @Test
+    public void testNull() {
+        assertNull(DistinguishedNames.canonicalize(null));
+        assertNull(DistinguishedNames.canonicalizeRegistry(null));
+    }
+
+}
@@ -0,0 +1,87 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.usermap;
+
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.Test;
+
+import java.util.concurrent.atomic.AtomicLong;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class MappingCacheTest {
+
+    private AtomicLong time;
+    private MappingCache<String, String> cache;
+
+    @BeforeEach
+    public void setUp() {
+        time = new AtomicLong(1000);
+        cache = new MappingCache<>(2, time::get);
+    }
+
+    @Test
+    public void testHitAndMiss() {
+        assertNull(cache.get("a"));
+        cache.put("a", "A", 10);
+        assertEquals("A", cache.get("a"));
+
+        CacheStatistics statistics = cache.getStatistics();
+        assertEquals(1, statistics.getHits());
+        assertEquals(1, statistics.getMisses());
+        assertEquals(1, statistics.getSize());
+    }
+
+    @Test
+    public void testExpiration() {
+        cache.put("a", "A", 10);
+        time.addAndGet(9);
+        assertEquals("A", cache.get("a"));
+        time.addAndGet(1);
+        assertNull(cache.get("a"));
+
+        assertEquals(1, cache.getStatistics().getExpirations());
+        assertEquals(0, cache.size());
+    }
+
+    @Test
+    public void testEvictionOfLeastRecentlyUsed() {
+        cache.put("a", "A", 10);
+        cache.put("b", "B", 10);
+        assertEquals("A", cache.get("a"));
+        cache.put("c", "C", 10);
+
+        assertEquals("A", cache.get("a"));
+        assertNull(cache.get("b"));
+        assertEquals("C", cache.get("c"));
+        assertEquals(1, cache.getStatistics().getEvictions());
+    }
+
+    @Test
+    public void testZeroTtlIsNotCached() {
+        cache.put("a", "A", 0);
+        assertNull(cache.get("a"));
+        assertEquals(0, cache.size());
+    }
+
+    @Test
+    public void testClear() {
+        cache.put("a", "A", 10);
+        cache.clear();
+        assertNull(cache.get("a"));
+    }
+
+    @Test
+    public void testInvalidSize() {
+        assertThrows(IllegalArgumentException.class, () -> new MappingCache<>(0));
+    }
+
+}
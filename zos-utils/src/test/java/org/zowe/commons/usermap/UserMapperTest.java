@@ -0,0 +1,338 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.usermap;
+
+import org.junit.jupiter.api.Test;
+
+import java.nio.ByteBuffer;
+import java.time.Duration;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class UserMapperTest {
+
+    private static final byte[] CERTIFICATE_1 = new byte[] {1, 2, 3};
+    private static final byte[] CERTIFICATE_2 = new byte[] {4, 5, 6};
+
+    @Test
+    public void testCertificate_whenNoCache() {
+        TestUserMapper userMapper = new TestUserMapper();
+        userMapper.getUserIDForCertificate(CERTIFICATE_1);
+        userMapper.getUserIDForCertificate(CERTIFICATE_1);
+
+        assertEquals(2, userMapper.certificateCalls.get());
+        assertNull(userMapper.getCertificateCacheStatistics());
+    }
+
+    @Test
+    public void testCertificate_whenCached() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        CertificateResponse response = userMapper.getUserIDForCertificate(CERTIFICATE_1);
+        assertEquals("USER", response.getUserId());
+        assertSame(response, userMapper.getUserIDForCertificate(new byte[] {1, 2, 3}));
+        assertNotSame(response, userMapper.getUserIDForCertificate(CERTIFICATE_2));
+
+        assertEquals(2, userMapper.certificateCalls.get());
+        assertEquals(1, userMapper.getCertificateCacheStatistics().getHits());
+        assertEquals(2, userMapper.getCertificateCacheStatistics().getMisses());
+
+        userMapper.clearCache();
+        userMapper.getUserIDForCertificate(CERTIFICATE_1);
+        assertEquals(3, userMapper.certificateCalls.get());
+    }
+
+    @Test
+    public void testCertificate_whenNegativeCachingIsDisabled() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().negativeTtl(Duration.ZERO).build());
+        userMapper.rc = 8;
+        userMapper.getUserIDForCertificate(CERTIFICATE_1);
+        userMapper.getUserIDForCertificate(CERTIFICATE_1);
+
+        assertEquals(2, userMapper.certificateCalls.get());
+    }
+
+    @Test
+    public void testCertificate_whenNegativeCachingIsEnabled() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        userMapper.rc = -1;
+        userMapper.errno = CertificateResponse.ERRNO_NOT_MAPPED;
+        userMapper.getUserIDForCertificate(CERTIFICATE_1);
+        userMapper.getUserIDForCertificate(CERTIFICATE_1);
+
+        assertEquals(1, userMapper.certificateCalls.get());
+    }
+
+    @Test
+    public void testCertificate_whenFailureIsNotCached() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        userMapper.rc = -1;
+        userMapper.errno = 163;
+        userMapper.getUserIDForCertificate(CERTIFICATE_1);
+        userMapper.getUserIDsForCertificates(new byte[][] {CERTIFICATE_1});
+
+        assertEquals(2, userMapper.certificateCalls.get());
+    }
+
+    @Test
+    public void testCertificate_whenDirectBuffer() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        CertificateResponse response = userMapper.getUserIDForCertificate(CERTIFICATE_1);
+
+        ByteBuffer buffer = ByteBuffer.allocateDirect(5);
+        buffer.put((byte) 9).put(CERTIFICATE_1).flip().position(1);
+        assertSame(response, userMapper.getUserIDForCertificate(buffer));
+        assertEquals(0, userMapper.directCalls.get());
+        assertEquals(1, buffer.position());
+
+        buffer.put(3, (byte) 7);
+        userMapper.getUserIDForCertificate(buffer);
+        assertEquals(1, userMapper.directCalls.get());
+        assertEquals(1, userMapper.lastOffset);
+        assertEquals(3, userMapper.lastLength);
+    }
+
+    @Test
+    public void testCertificate_whenHeapBuffer() {
+        TestUserMapper userMapper = new TestUserMapper();
+        userMapper.getUserIDForCertificate(ByteBuffer.wrap(CERTIFICATE_1));
+
+        assertEquals(1, userMapper.certificateCalls.get());
+        assertEquals(0, userMapper.directCalls.get());
+    }
+
+    @Test
+    public void testDN_whenDirectBuffers() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        ByteBuffer dn = ByteBuffer.allocateDirect(16);
+        dn.position(2).limit(10);
+        ByteBuffer registry = ByteBuffer.allocateDirect(8);
+
+        assertEquals("USER", userMapper.getUserIDForDN(dn, registry).getUserId());
+        userMapper.getUserIDForDN(dn, registry);
+        assertEquals(2, userMapper.directCalls.get());
+        assertEquals(2, userMapper.lastOffset);
+        assertEquals(8, userMapper.lastLength);
+        assertEquals(2, dn.position());
+    }
+
+    @Test
+    public void testDN_whenNoCache() {
+        TestUserMapper userMapper = new TestUserMapper();
+        userMapper.getUserIDForDN("CN=user", "registry");
+        userMapper.getUserIDForDN("CN=user", "registry");
+
+        assertEquals(2, userMapper.dnCalls.get());
+        assertNull(userMapper.getDnCacheStatistics("registry"));
+    }
+
+    @Test
+    public void testDN_whenEquivalentNames() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        MapperResponse response = userMapper.getUserIDForDN("CN=John Smith,O=Org", "registry");
+        assertSame(response, userMapper.getUserIDForDN("cn=john smith; o=org", "Registry"));
+
+        assertEquals(1, userMapper.dnCalls.get());
+        assertEquals(1, userMapper.getDnCacheStatistics("registry").getHits());
+    }
+
+    @Test
+    public void testDN_whenDifferentRegistries() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        userMapper.getUserIDForDN("CN=user", "registry1");
+        userMapper.getUserIDForDN("CN=user", "registry2");
+
+        assertEquals(2, userMapper.dnCalls.get());
+        assertEquals(1, userMapper.getDnCacheStatistics("registry1").getSize());
+        assertEquals(1, userMapper.getDnCacheStatistics("registry2").getSize());
+    }
+
+    @Test
+    public void testDN_whenNotMapped() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        userMapper.rc = 8;
+        userMapper.racfRs = MapperResponse.RACF_RS_NOT_MAPPED;
+        userMapper.getUserIDForDN("CN=user", "registry");
+        userMapper.getUserIDForDN("CN=user", "registry");
+
+        assertEquals(1, userMapper.dnCalls.get());
+    }
+
+    @Test
+    public void testDN_whenFailureIsNotCached() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        userMapper.rc = 8;
+        userMapper.racfRs = 12;
+        userMapper.getUserIDForDN("CN=user", "registry");
+        userMapper.getUserIDsForDNs(new String[] {"CN=user"}, "registry");
+
+        assertEquals(2, userMapper.dnCalls.get());
+    }
+
+    @Test
+    public void testDN_whenNullRegistry() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        assertThrows(IllegalArgumentException.class, () -> userMapper.getUserIDForDN("CN=user", null));
+        assertThrows(IllegalArgumentException.class, () -> new TestUserMapper().getUserIDForDN("CN=user", null));
+        assertThrows(IllegalArgumentException.class, () -> userMapper.getUserIDsForDNs(new String[] {"CN=user"}, null));
+        assertEquals(0, userMapper.dnCalls.get());
+    }
+
+    @Test
+    public void testDN_whenTooManyRegistries() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().maxRegistries(1).build());
+        userMapper.getUserIDForDN("CN=user", "registry1");
+        userMapper.getUserIDForDN("CN=user", "registry1");
+        userMapper.getUserIDForDN("CN=user", "registry2");
+        userMapper.getUserIDForDN("CN=user", "registry2");
+
+        assertEquals(3, userMapper.dnCalls.get());
+        assertNotNull(userMapper.getDnCacheStatistics("registry1"));
+        assertNull(userMapper.getDnCacheStatistics("registry2"));
+    }
+
+    @Test
+    public void testCertificates_whenNoCache() {
+        TestUserMapper userMapper = new TestUserMapper();
+        CertificateResponse[] responses = userMapper.getUserIDsForCertificates(new byte[][] {CERTIFICATE_1, CERTIFICATE_2});
+
+        assertEquals(2, responses.length);
+        assertEquals(1, userMapper.batchCalls.get());
+        assertEquals(2, userMapper.certificateCalls.get());
+    }
+
+    @Test
+    public void testCertificates_whenPartiallyCached() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        CertificateResponse cached = userMapper.getUserIDForCertificate(CERTIFICATE_2);
+        CertificateResponse[] responses = userMapper.getUserIDsForCertificates(new byte[][] {CERTIFICATE_1, CERTIFICATE_2});
+
+        assertNotNull(responses[0]);
+        assertSame(cached, responses[1]);
+        assertEquals(1, userMapper.batchCalls.get());
+        assertEquals(2, userMapper.certificateCalls.get());
+
+        CertificateResponse[] again = userMapper.getUserIDsForCertificates(new byte[][] {CERTIFICATE_1, CERTIFICATE_2});
+        assertSame(responses[0], again[0]);
+        assertEquals(1, userMapper.batchCalls.get());
+    }
+
+    @Test
+    public void testDNs_whenPartiallyCached() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        MapperResponse cached = userMapper.getUserIDForDN("CN=b", "registry");
+        MapperResponse[] responses = userMapper.getUserIDsForDNs(new String[] {"CN=a", "cn=b", "CN=c"}, "registry");
+
+        assertEquals(3, responses.length);
+        assertSame(cached, responses[1]);
+        assertEquals(1, userMapper.batchCalls.get());
+        assertEquals(3, userMapper.dnCalls.get());
+    }
+
+    @Test
+    public void testCertificate_whenNull() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        assertThrows(IllegalArgumentException.class, () -> userMapper.getUserIDForCertificate((byte[]) null));
+        assertThrows(IllegalArgumentException.class, () -> new TestUserMapper().getUserIDForCertificate((byte[]) null));
+        assertEquals(0, userMapper.certificateCalls.get());
+    }
+
+    @Test
+    public void testCertificates_whenNullElement() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        assertThrows(IllegalArgumentException.class, () -> userMapper.getUserIDsForCertificates(null));
+        assertThrows(IllegalArgumentException.class,
+            () -> userMapper.getUserIDsForCertificates(new byte[][] {CERTIFICATE_1, null}));
+        assertThrows(IllegalArgumentException.class,
+            () -> new TestUserMapper().getUserIDsForCertificates(new byte[][] {null}));
+        assertEquals(0, userMapper.batchCalls.get());
+    }
+
+    @Test
+    public void testDNs_whenNullElement() {
+        TestUserMapper userMapper = new TestUserMapper(UserMapperCacheConfig.builder().build());
+        assertThrows(IllegalArgumentException.class, () -> userMapper.getUserIDsForDNs(null, "registry"));
+        assertThrows(IllegalArgumentException.class,
+            () -> userMapper.getUserIDsForDNs(new String[] {"cn=a", null}, "registry"));
+        assertEquals(0, userMapper.batchCalls.get());
+    }
+
+    static class TestUserMapper extends UserMapper {
+
+        final AtomicInteger batchCalls = new AtomicInteger();
+
+        final AtomicInteger certificateCalls = new AtomicInteger();
+        final AtomicInteger dnCalls = new AtomicInteger();
+        final AtomicInteger directCalls = new AtomicInteger();
+        int lastOffset;
+        int lastLength;
+        int rc;
+        int errno;
+        int racfRs;
+
+        TestUserMapper() {
+            super();
+        }
+
+        TestUserMapper(UserMapperCacheConfig cacheConfig) {
+            super(cacheConfig);
+        }
+
+        @Override
+        CertificateResponse mapCertificate(byte[] certificate) {
+            certificateCalls.incrementAndGet();
+            return new CertificateResponse(rc == 0 ? "USER" : "", rc, errno, 0);
+        }
+
+        @Override
+        MapperResponse mapDN(String distinguishedName, String registry) {
+            dnCalls.incrementAndGet();
+            return new MapperResponse(rc == 0 ? "USER" : "", rc, rc, rc, racfRs);
+        }
+
+        @Override
+        CertificateResponse mapCertificateDirect(ByteBuffer certificate, int offset, int length) {
+            directCalls.incrementAndGet();
+            lastOffset = offset;
+            lastLength = length;
+            return new CertificateResponse("USER", 0, 0, 0);
+        }
+
+        @Override
+        MapperResponse mapDNDirect(
+            ByteBuffer distinguishedName, int distinguishedNameOffset, int distinguishedNameLength,
+            ByteBuffer registry, int registryOffset, int registryLength
+        ) {
+            directCalls.incrementAndGet();
+            lastOffset = distinguishedNameOffset;
+            lastLength = distinguishedNameLength;
+            return new MapperResponse("USER", 0, 0, 0, 0);
+        }
+
+        @Override
+        CertificateResponse[] mapCertificates(byte[][] certificates) {
+            batchCalls.incrementAndGet();
+            CertificateResponse[] out = new CertificateResponse[certificates.length];
+            for (int i = 0; i < certificates.length; i++) out[i] = mapCertificate(certificates[i]);
+            return out;
+        }
+
+        @Override
+        MapperResponse[] mapDNs(String[] distinguishedNames, String registry) {
+            batchCalls.incrementAndGet();
+            MapperResponse[] out = new MapperResponse[distinguishedNames.length];
+            for (int i = 0; i < distinguishedNames.length; i++) out[i] = mapDN(distinguishedNames[i], registry);
+            return out;
+        }
+
+    }
+
+}
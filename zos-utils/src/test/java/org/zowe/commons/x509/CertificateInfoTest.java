@@ -0,0 +1,84 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+package org.zowe.commons.x509;
+
+import org.junit.jupiter.api.Test;
+
+import java.io.ByteArrayInputStream;
+import java.math.BigInteger;
+import java.security.cert.CertificateFactory;
+import java.security.cert.X509Certificate;
+import java.time.Instant;
+import java.util.Base64;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+public class CertificateInfoTest {
+
+    private static final String CERTIFICATE =
+        "MIIBpzCCAUygAwIBAgIFAKGyw9QwCgYIKoZIzj0EAwIwMDELMAkGA1UEBhMCQ1oxDTALBgNVBAoMBFpvd2UxEjAQBgNVBAMMCXRl" +
+        "c3QgdXNlcjAeFw0yNjEwMTcwNDE2MjRaFw0zNjEwMTQwNDE2MjRaMDAxCzAJBgNVBAYTAkNaMQ0wCwYDVQQKDARab3dlMRIwEAYD" +
+        "VQQDDAl0ZXN0IHVzZXIwWTATBgcqhkjOPQIBBggqhkjOPQMBBwNCAATxrrKcCIBeZiWp/67NXz3YH57M6GsP9XNcvDKlrtmy+DLY" +
+        "48o7Qw2FvusBm+LOh6IaNQQ1ZRsMxsxzUvi7syDyo1MwUTAdBgNVHQ4EFgQUzIitctkYV0nrZeTqgz/DQmBofOcwHwYDVR0jBBgw" +
+        "FoAUzIitctkYV0nrZeTqgz/DQmBofOcwDwYDVR0TAQH/BAUwAwEB/zAKBggqhkjOPQQDAgNJADBGAiEArW4dXjTOlP4yZsZY785P" +
+        "zMOZkdt/3v8jJhPQSYFfiQcCIQCMenr00n/0bQYmFekjaG5Qn7Oni+M1ngQW5WeqjGohaQ==";
+
+    private static final String FINGERPRINT = "1A0CB2AF19B786C09E72CF113931D312D868FAD30F0EB318D5CA364FF82E7AB4";
+
+    /**
+     * Creates the info as native code does (DER of names, content of serial number)
+     */
+    private CertificateInfo createInfo() throws Exception {
+        X509Certificate certificate = (X509Certificate) CertificateFactory.getInstance("X.509")
+            .generateCertificate(new ByteArrayInputStream(Base64.getDecoder().decode(CERTIFICATE)));
+        byte[] fingerprint = new byte[FINGERPRINT.length() / 2];
+        for (int i = 0; i < fingerprint.length; i++) {
+            fingerprint[i] = (byte) Integer.parseInt(FINGERPRINT.substring(i * 2, i * 2 + 2), 16);
+        }
+        return new CertificateInfo(
+            certificate.getSerialNumber().toByteArray(),
+            certificate.getIssuerX500Principal().getEncoded(),
+            certificate.getSubjectX500Principal().getEncoded(),
+            1792210584000L,
+            2107570584000L,
+            fingerprint
+        );
+    }
+
+    @Test
+    public void testGetters() throws Exception {
+        CertificateInfo info = createInfo();
+        assertEquals(new BigInteger("A1B2C3D4", 16), info.getSerialNumber());
+        assertEquals("CN=test user,O=Zowe,C=CZ", info.getSubjectDN());
+        assertEquals("CN=test user,O=Zowe,C=CZ", info.getIssuerDN());
+        assertEquals(Instant.parse("2026-10-17T04:16:24Z"), info.getNotBefore());
+        assertEquals(Instant.parse("2036-10-14T04:16:24Z"), info.getNotAfter());
+        assertEquals(FINGERPRINT, info.getFingerprintHex());
+        assertEquals(32, info.getFingerprint().length);
+    }
+
+    @Test
+    public void testValidity() throws Exception {
+        CertificateInfo info = createInfo();
+        assertTrue(info.isValidAt(Instant.parse("2030-01-01T00:00:00Z")));
+        assertTrue(info.isValidAt(info.getNotAfter()));
+        assertFalse(info.isValidAt(Instant.parse("2026-10-17T04:16:23Z")));
+        assertFalse(info.isValidAt(Instant.parse("2036-10-14T04:16:25Z")));
+    }
+
+    @Test
+    public void testFingerprintIsNotShared() throws Exception {
+        CertificateInfo info = createInfo();
+        info.getFingerprint()[0] = 0;
+        assertEquals(FINGERPRINT, info.getFingerprintHex());
+        assertEquals(createInfo(), info);
+    }
+
+}
@@ -0,0 +1,43 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.zos;
+
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.Test;
+
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+import static org.junit.jupiter.api.Assumptions.assumeFalse;
+
+public class NativeLibraryLoaderTest {
+
+    @AfterEach
+    public void tearDown() {
+        System.clearProperty(NativeLibraryLoader.SIMULATOR_PROPERTY);
+    }
+
+    @Test
+    public void testLoad_whenNotZosAndSimulatorIsDisabled() {
+        assumeFalse(NativeLibraryLoader.isZos());
+        assertFalse(NativeLibraryLoader.isSimulator());
+        assertFalse(NativeLibraryLoader.load("zowe-does-not-exist"));
+    }
+
+    @Test
+    public void testLoad_whenSimulatorIsEnabled() {
+        assumeFalse(NativeLibraryLoader.isZos());
+        System.setProperty(NativeLibraryLoader.SIMULATOR_PROPERTY, "true");
+        assertTrue(NativeLibraryLoader.isSimulator());
+        assertThrows(UnsatisfiedLinkError.class, () -> NativeLibraryLoader.load("zowe-does-not-exist"));
+    }
+
+}
@@ -0,0 +1,130 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+package org.zowe.commons.zos;
+
+import org.junit.jupiter.api.Test;
+
+import javax.management.MBeanServer;
+import javax.management.ObjectName;
+import java.lang.management.ManagementFactory;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+public class NativeMetricsTest {
+
+    private static final int BUCKETS = 160;
+    private static final int CODE_SLOTS = 32;
+    private static final String[] OPERATIONS = {"certificate", "dn"};
+
+    /**
+     * Values in the same format as metrics_copy in nativeMetrics.c
+     */
+    private long[] values() {
+        long[] values = new long[5 + OPERATIONS.length * (4 + BUCKETS) + 4 * CODE_SLOTS];
+        values[0] = 1;
+        values[1] = OPERATIONS.length;
+        values[2] = BUCKETS;
+        values[3] = CODE_SLOTS;
+        values[4] = 7;
+
+        // certificate: 9 calls in bucket 40 (2048 - 2559 ns) and 1 call in bucket 60 (65536 - 81919 ns)
+        int certificate = 5;
+        values[certificate] = 10;
+        values[certificate + 1] = 1;
+        values[certificate + 2] = 9 * 2100 + 70000;
+        values[certificate + 3] = 70000;
+        values[certificate + 4 + 40] = 9;
+        values[certificate + 4 + 60] = 1;
+
+        int codes = 5 + OPERATIONS.length * (4 + BUCKETS);
+        values[codes] = 111;
+        values[codes + 1] = 1;
+        values[codes + 2 * CODE_SLOTS] = 0x1234;
+        values[codes + 2 * CODE_SLOTS + 1] = 1;
+        return values;
+    }
+
+    private NativeMetrics metrics() {
+        long[] values = values();
+        return new NativeMetrics("test", OPERATIONS, target -> {
+            if (target != null && target.length >= values.length) {
+                System.arraycopy(values, 0, target, 0, values.length);
+            }
+            return values.length;
+        });
+    }
+
+    @Test
+    public void testBucketBounds() {
+        assertEquals(0, OperationMetrics.bucketLowerBound(0));
+        assertEquals(3, OperationMetrics.bucketLowerBound(3));
+        assertEquals(4, OperationMetrics.bucketLowerBound(4));
+        assertEquals(7, OperationMetrics.bucketLowerBound(7));
+        assertEquals(8, OperationMetrics.bucketLowerBound(8));
+        assertEquals(10, OperationMetrics.bucketLowerBound(9));
+        assertEquals(2048, OperationMetrics.bucketLowerBound(40));
+        assertEquals(65536, OperationMetrics.bucketLowerBound(60));
+    }
+
+    @Test
+    public void testSnapshot() {
+        NativeMetricsSnapshot snapshot = metrics().getSnapshot();
+
+        assertEquals(2, snapshot.getOperations().size());
+        assertEquals(7, snapshot.getCodesOverflow());
+        assertEquals(1L, snapshot.getErrnoCounts().get(111));
+        assertEquals(1L, snapshot.getErrno2Counts().get(0x1234));
+        assertNull(snapshot.getOperation("unknown"));
+
+        OperationMetrics certificate = snapshot.getOperation("certificate");
+        assertEquals(10, certificate.getCount());
+        assertEquals(1, certificate.getErrors());
+        assertEquals(8890.0, certificate.getMeanNanos());
+        assertEquals(2559, certificate.getPercentileNanos(50));
+        assertEquals(70000, certificate.getPercentileNanos(99));
+
+        OperationMetrics dn = snapshot.getOperation("dn");
+        assertEquals(0, dn.getCount());
+        assertEquals(0.0, dn.getMeanNanos());
+        assertEquals(0, dn.getPercentileNanos(99));
+    }
+
+    @Test
+    public void testUnsupportedVersion() {
+        long[] values = values();
+        values[0] = 2;
+        assertThrows(IllegalArgumentException.class, () -> NativeMetricsSnapshot.parse(OPERATIONS, values));
+    }
+
+    @Test
+    public void testMXBean() throws Exception {
+        NativeMetrics metrics = metrics();
+
+        assertEquals(10L, metrics.getCounts().get("certificate"));
+        assertEquals(1L, metrics.getErrors().get("certificate"));
+        assertEquals(70.0, metrics.getMaxMicros().get("certificate"));
+        assertEquals(2.559, metrics.getMedianMicros().get("certificate"));
+        assertEquals(1L, metrics.getErrno2Counts().get("1234"));
+
+        ObjectName name = metrics.register();
+        try {
+            MBeanServer server = ManagementFactory.getPlatformMBeanServer();
+            assertTrue(server.isRegistered(name));
+            assertEquals(7L, server.getAttribute(name, "CodesOverflow"));
+        } finally {
+            ManagementFactory.getPlatformMBeanServer().unregisterMBean(name);
+        }
+    }
+
+}
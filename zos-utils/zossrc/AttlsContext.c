@@ -12,16 +12,19 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
-#include <resolv.h>
-#include <ezbztlsc.h>
+#include "attlsBackend.h"
+#include "nativeMetrics.h"
+#include "connectionStats.h"
+#include "userIdIntern.h"
+#include "certificateInfo.h"
+#include "transcode.h"
 
 /**
  * The fields between the pragmas below need to be in ASCII.
  *
- * Runtime translations can be done via:
- *   __etoa() EBCDIC to ASCII
- *   __atoe() ASCII to EBCDIC
+ * Values of ioctl (EBCDIC) are converted at runtime by transcode.h, directly between EBCDIC and Java strings.
  */
 #if defined(__IBMC__) || defined(__IBMCPP__)
 #pragma convert(819)
@@ -32,35 +35,54 @@
  */
 const char *JNI_SIGNATURE_PROPERTY_BOOLEAN = "Z";
 const char *JNI_SIGNATURE_PROPERTY_INTEGER = "I";
+const char *JNI_SIGNATURE_PROPERTY_LONG = "J";
 const char *JNI_SIGNATURE_PROPERTY_BYTE_ARRAY = "[B";
+const char *JNI_SIGNATURE_PROPERTY_BYTE_BUFFER = "Ljava/nio/ByteBuffer;";
 const char *JNI_SIGNATURE_PROPERTY_STRING = "Ljava/lang/String;";
 const char *JNI_SIGNATURE_PROPERTY_STAT_POLICY = "Lorg/zowe/commons/attls/StatPolicy;";
 const char *JNI_SIGNATURE_PROPERTY_STAT_CONN = "Lorg/zowe/commons/attls/StatConn;";
 const char *JNI_SIGNATURE_PROPERTY_PROTOCOL = "Lorg/zowe/commons/attls/Protocol;";
 const char *JNI_SIGNATURE_PROPERTY_SECURITY_TYPE = "Lorg/zowe/commons/attls/SecurityType;";
 const char *JNI_SIGNATURE_PROPERTY_FIPS_140 = "Lorg/zowe/commons/attls/Fips140;";
+const char *JNI_SIGNATURE_PROPERTY_CIPHER_SUITE = "Lorg/zowe/commons/attls/CipherSuite;";
+const char *JNI_SIGNATURE_PROPERTY_COMPLETABLE_FUTURE = "Ljava/util/concurrent/CompletableFuture;";
+const char *JNI_SIGNATURE_PROPERTY_CERTIFICATE_INFO = "Lorg/zowe/commons/x509/CertificateInfo;";
 
 /**
  * type signature of methods used in AttlsContext in ASCII
  */
-const char *JNI_SIGNATURE_METHOD_BYTE_BYTE_PROTOCOL = "(BB)Lorg/zowe/commons/attls/Protocol;";
 const char *JNI_SIGNATURE_METHOD_NONE_BYTE = "()B";
-const char *JNI_SIGNATURE_METHOD_ENUM_BYTE_VOID = "(Ljava/lang/Enum;B)V";
-const char *JNI_SIGNATURE_METHOD_ENUM_BYTE_BYTE_VOID = "(Ljava/lang/Enum;BB)V";
+const char *JNI_SIGNATURE_METHOD_CLASS_BYTE_VOID = "(Ljava/lang/Class;B)V";
+const char *JNI_SIGNATURE_METHOD_CLASS_BYTE_BYTE_VOID = "(Ljava/lang/Class;BB)V";
 const char *JNI_SIGNATURE_METHOD_INT_INT_INT_VOID = "(III)V";
+const char *JNI_SIGNATURE_METHOD_STRING_INT_INT_INT_VOID = "(Ljava/lang/String;III)V";
 const char *JNI_SIGNATURE_METHOD_NONE_ARRAY_PREFIX = "()[L";
 const char *JNI_SIGNATURE_METHOD_SEMICOLON_SUFFIX = ";";
+const char *JNI_SIGNATURE_METHOD_INT_BYTE_BUFFER = "(I)Ljava/nio/ByteBuffer;";
+const char *JNI_SIGNATURE_METHOD_NONE_STRING = "()Ljava/lang/String;";
+const char *JNI_SIGNATURE_METHOD_NONE_CIPHER_SUITE_ARRAY = "()[Lorg/zowe/commons/attls/CipherSuite;";
+
+/**
+ * 2-character code of negotiated cipher if the cipher has only 4-character code
+ */
+const char *JNI_CIPHER_4X = "4X";
 
 /**
  * name of properties used in AttlsContext in ASCII
  */
-const char *JNI_PROPERTY_BUFFER_CERTIFICATE_LENGTH = "BUFFER_CERTIFICATE_LENGTH";
+const char *JNI_PROPERTY_BUFFER_CERTIFICATE_MIN_LENGTH = "BUFFER_CERTIFICATE_MIN_LENGTH";
+const char *JNI_PROPERTY_BUFFER_CERTIFICATE_MAX_LENGTH = "BUFFER_CERTIFICATE_MAX_LENGTH";
 const char *JNI_PROPERTY_ALWAYS_LOAD_CERTIFICATE = "alwaysLoadCertificate";
+const char *JNI_PROPERTY_DIRECT_MEMORY = "directMemory";
+const char *JNI_PROPERTY_CACHE_CERTIFICATE = "cacheCertificate";
 const char *JNI_PROPERTY_ID = "id";
 const char *JNI_PROPERTY_IOCTL = "ioctl";
 const char *JNI_PROPERTY_BUFFER_CERTIFICATE = "bufferCertificate";
+const char *JNI_PROPERTY_IOCTL_DIRECT = "ioctlDirect";
+const char *JNI_PROPERTY_BUFFER_CERTIFICATE_DIRECT = "bufferCertificateDirect";
 const char *JNI_PROPERTY_QUERY_LOADED = "queryLoaded";
 const char *JNI_PROPERTY_CERTIFICATE_LOADED = "certificateLoaded";
+const char *JNI_PROPERTY_CONNECTION_STATS_KEY = "connectionStatsKey";
 const char *JNI_PROPERTY_STAT_POLICY_CACHE = "statPolicyCache";
 const char *JNI_PROPERTY_STAT_CONN_CACHE = "statConnCache";
 const char *JNI_PROPERTY_PROTOCOL_CACHE = "protocolCache";
@@ -69,8 +91,14 @@ const char *JNI_PROPERTY_SECURITY_TYPE_CACHE = "securityTypeCache";
 const char *JNI_PROPERTY_USER_ID_CACHE = "userIdCache";
 const char *JNI_PROPERTY_FIPS_140_CACHE = "fips140Cache";
 const char *JNI_PROPERTY_NEGOTIATED_CIPHER_4_CACHE = "negotiatedCipher4Cache";
+const char *JNI_PROPERTY_CIPHER_SUITE_CACHE = "cipherSuiteCache";
 const char *JNI_PROPERTY_NEGOTIATED_KEY_SHARE_CACHE = "negotiatedKeyShareCache";
 const char *JNI_PROPERTY_CERTIFICATE_CACHE = "certificateCache";
+const char *JNI_PROPERTY_CERTIFICATE_INFO_CACHE = "certificateInfoCache";
+const char *JNI_PROPERTY_QUERY_FUTURE = "queryFuture";
+const char *JNI_PROPERTY_CERTIFICATE_FUTURE = "certificateFuture";
+const char *JNI_PROPERTY_TOLERATE_UNKNOWN_VALUES = "tolerateUnknownValues";
+const char *JNI_PROPERTY_UNRECOGNIZED = "UNRECOGNIZED";
 
 /**
  * name of classes used in AttlsContext in ASCII
@@ -81,22 +109,28 @@ const char *JNI_CLASS_STAT_CONN = "org/zowe/commons/attls/StatConn";
 const char *JNI_CLASS_SECURITY_TYPE = "org/zowe/commons/attls/SecurityType";
 const char *JNI_CLASS_FIPS_140 = "org/zowe/commons/attls/Fips140";
 const char *JNI_CLASS_PROTOCOL = "org/zowe/commons/attls/Protocol";
+const char *JNI_CLASS_CIPHER_SUITE = "org/zowe/commons/attls/CipherSuite";
 const char *JNI_CLASS_ILLEGAL_ARGUMENT_EXCEPTION = "java/lang/IllegalArgumentException";
 const char *JNI_CLASS_UNKNOWN_ENUM_VALUE_EXCEPTION = "org/zowe/commons/attls/UnknownEnumValueException";
 const char *JNI_CLASS_IOCTL_CALL_EXCEPTION = "org/zowe/commons/attls/IoctlCallException";
+const char *JNI_CLASS_CERTIFICATE_RESPONSE = "org/zowe/commons/usermap/CertificateResponse";
 
 /**
  * name of method used in AttlsContext in ASCII
  */
 const char *JNI_METHOD_CONSTRUCTOR = "<init>";
-const char *JNI_METHOD_VALUE_OF = "valueOf";
 const char *JNI_METHOD_VALUES = "values";
 const char *JNI_METHOD_GET_VALUE = "getValue";
+const char *JNI_METHOD_GET_VERSION = "getVersion";
+const char *JNI_METHOD_GET_MOD = "getMod";
+const char *JNI_METHOD_GET_CODE_2 = "getCode2";
+const char *JNI_METHOD_GET_CODE_4 = "getCode4";
 
 /**
  * error messages in ASCII
  */
 const char *JNI_MESSAGE_CANNOT_CONVERT_USER_ID = "Cannot convert userID";
+const char *JNI_MESSAGE_OUT_OF_BUFFER = "Region is out of the buffer";
 
 /**
  * signatures to get method Arrays.fill - clean up of arrays
@@ -105,6 +139,12 @@ const char *JNI_SIGNATURE_ARRAYS = "java/util/Arrays";
 const char *JNI_SIGNATURE_ARRAYS_FILL = "fill";
 const char *JNI_SIGNATURE_METHOD_BYTE_ARRAY_BYTE_VOID = "([BB)V";
 
+/**
+ * signatures to get method ByteBuffer.allocateDirect - allocation of native memory
+ */
+const char *JNI_CLASS_BYTE_BUFFER = "java/nio/ByteBuffer";
+const char *JNI_METHOD_ALLOCATE_DIRECT = "allocateDirect";
+
 #if defined(__IBMC__) || defined(__IBMCPP__)
 #pragma convert(0)
 #endif
@@ -120,9 +160,36 @@ const char *JNI_SIGNATURE_METHOD_BYTE_ARRAY_BYTE_VOID = "([BB)V";
  */
 #define JNI_VERSION JNI_VERSION_1_8
 
+/**
+ * Positions of values in packed status (see PackedStatus.java)
+ */
+#define PACKED_STATUS_STAT_POLICY_SHIFT         0
+#define PACKED_STATUS_STAT_CONN_SHIFT           8
+#define PACKED_STATUS_PROTOCOL_VERSION_SHIFT   16
+#define PACKED_STATUS_PROTOCOL_MOD_SHIFT       24
+#define PACKED_STATUS_SECURITY_TYPE_SHIFT      32
+#define PACKED_STATUS_FIPS_140_SHIFT           40
+#define PACKED_STATUS_FLAGS_SHIFT              48
+#define PACKED_STATUS_USER_ID_LENGTH_SHIFT     56
+#define PACKED_STATUS_BYTE(value, shift) (((jlong) ((unsigned char) (value))) << (shift))
+
+/**
+ * Operations measured by metrics (see NativeMetrics.ATTLS_OPERATIONS)
+ */
+#define METRICS_QUERY                   0
+#define METRICS_QUERY_CERTIFICATE       1
+#define METRICS_INIT_CONNECTION         2
+#define METRICS_RESET_SESSION           3
+#define METRICS_RESET_CIPHER            4
+#define METRICS_STOP_CONNECTION         5
+#define METRICS_ALLOW_HSTIMEOUT         6
+#define METRICS_MAP_CERTIFICATE         7
+#define METRICS_OPERATIONS              8
+
 /**
   * Struct for fast mapping byte values into enumeration. It is possible to use to value which are close to zero.
-  * It prepare array and mapping is via index of arrray.
+  * It prepare array and mapping is via index of arrray. The key could have one or two bytes (ie. Protocol is identified
+  * by version and modifier), the value of key (key1, key2) is stored at index key1 * size2 + key2.
   */
 typedef struct enum_map {
     // enumeration Class
@@ -131,8 +198,11 @@ typedef struct enum_map {
     const char* clazzName;
     // array with all values from enumeration
     jobject* values;
-    // max value stored into array (to check input value)
-    int max_value;
+    // count of possible values of the first and the second byte of the key (size2 is 1 for one byte keys)
+    int size1;
+    int size2;
+    // value UNRECOGNIZED returned in tolerant mode instead of exception (it is not stored in values)
+    jobject unrecognized;
 } EnumMap;
 
 /**
@@ -144,11 +214,16 @@ jclass attls_context_clazz;
  * Cached references to properties of AttlsContext to faster using
  */
 jfieldID always_load_certificate_field;
+jfieldID direct_memory_field;
+jfieldID cache_certificate_field;
 jfieldID id_field;
 jfieldID ioctl_field;
 jfieldID buffer_certificate_field;
+jfieldID ioctl_direct_field;
+jfieldID buffer_certificate_direct_field;
 jfieldID query_loaded_field;
 jfieldID certificate_loaded_field;
+jfieldID connection_stats_key_field;
 jfieldID stat_policy_cache_field;
 jfieldID stat_conn_cache_field;
 jfieldID protocol_cache_field;
@@ -157,13 +232,30 @@ jfieldID security_type_cache_field;
 jfieldID user_id_cache_field;
 jfieldID fips140_cache_field;
 jfieldID negotiated_cipher4_cache_field;
+jfieldID cipher_suite_cache_field;
 jfieldID negotiated_key_share_cache_field;
 jfieldID certificate_cache_field;
+jfieldID certificate_info_cache_field;
+jfieldID query_future_field;
+jfieldID certificate_future_field;
+jfieldID tolerate_unknown_values_field;
 
 /**
- * Size of buffer to fetch certificate
+ * Version of query request. Version 2 returns also extended fields (ie. negotiated key share) in the same call. The
+ * first successful query probes it: version 2 is sent and if the stack rejects it (EINVAL), the request is repeated
+ * with version 1, which is used since then. Only a plain query is a probe, EINVAL of a command (ie. the connection is
+ * in a wrong state) says nothing about the version.
  */
-int buffer_certificate_size;
+#define QUERY_VERSION_UNKNOWN 0
+volatile int query_version = QUERY_VERSION_UNKNOWN;
+
+/**
+ * Sizes of buffer to fetch certificate. Buffers are allocated by size classes (powers of two) between min and max size.
+ * The initial size is derived from typical size of certificates, which is learnt from loaded certificates.
+ */
+int buffer_certificate_min_size;
+int buffer_certificate_max_size;
+int buffer_certificate_typical_size;
 
 /**
  * Prepared mapping from byte value into enumerations
@@ -172,12 +264,29 @@ EnumMap* stat_policy_enum_map;
 EnumMap* stat_conn_enum_map;
 EnumMap* security_type_enum_map;
 EnumMap* fips140_enum_map;
+EnumMap* protocol_enum_map;
+
+/**
+ * Entry of table of ciphers: code in EBCDIC as returned by ioctl (padded by zeros), shared Java string of the code and
+ * the cipher suite (NULL for codes without a suite, ie. "4X").
+ */
+typedef struct cipher_entry {
+    char code[4];
+    jstring name;
+    jobject suite;
+} CipherEntry;
 
 /**
- * Class and filed of protocol enumeration (there is not possible to use EnumMap, because it is identified by 2 bytes)
+ * Table of ciphers sorted by code, it is built on loading from enumeration CipherSuite
  */
-jclass enum_protocol_clazz;
-jmethodID protocol_value_of_method_ID;
+typedef struct cipher_table {
+    int code_length;
+    int count;
+    CipherEntry* entries;
+} CipherTable;
+
+CipherTable cipher2_table = { 2, 0, NULL };
+CipherTable cipher4_table = { 4, 0, NULL };
 
 /**
  * Class Arrays and method Arrays.fill(byte[], byte) to clean byte arrays
@@ -185,6 +294,34 @@ jmethodID protocol_value_of_method_ID;
 jclass arraysClass;
 jmethodID arrays_fill_method_ID;
 
+/**
+ * Class ByteBuffer and method ByteBuffer.allocateDirect(int) to allocate native memory owned by Java
+ */
+jclass byte_buffer_clazz;
+jmethodID allocate_direct_method_ID;
+
+/**
+ * Exceptions thrown by the library and their constructors, they are resolved on loading to make failures cheap
+ */
+jclass illegal_argument_exception_clazz;
+jclass unknown_enum_value_exception_clazz;
+jmethodID unknown_enum_value_exception_constructor;
+jmethodID unknown_enum_value_exception_protocol_constructor;
+jclass ioctl_call_exception_clazz;
+jmethodID ioctl_call_exception_constructor;
+jclass certificate_response_clazz;
+jmethodID certificate_response_constructor;
+
+/**
+ * Counters and latency histograms of ioctl calls
+ */
+Metrics metrics = { METRICS_OPERATIONS };
+
+/**
+ * Counters of policy status, connection status, protocol, cipher and FIPS 140 of queried connections
+ */
+ConnectionStats connection_stats;
+
 int strnlen(char *txt, int max) {
     if (max < 0) return 0;
     for (int i = 0; i < max; i++) {
@@ -200,105 +337,221 @@ jstring get_jstring(JNIEnv *env, char* ebcdic, int length)
 {
     if (!ebcdic || (length < 0)) return NULL;
 
-    int realSize = strnlen(ebcdic, length);
-    if (realSize < length) {
-        length = realSize;
-    }
-    char *output = (char*) __malloc31(length + 1);
-    strncpy(output, ebcdic, length);
-    output[length] = 0;
-
-    int size = __etoa(output);
-    if (size < 0) {
-        jclass exception_clazz = (*env) -> FindClass(env, JNI_CLASS_ILLEGAL_ARGUMENT_EXCEPTION);
-        (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_CANNOT_CONVERT_USER_ID);
-        free(output);
-        return NULL;
+    jstring out = transcode_new_string(env, ebcdic, length);
+    if (!out && !(*env) -> ExceptionCheck(env)) {
+        (*env) -> ThrowNew(env, illegal_argument_exception_clazz, JNI_MESSAGE_CANNOT_CONVERT_USER_ID);
     }
+    return out;
+}
 
-    jstring outputJstring = (*env) -> NewStringUTF(env, output);
-    free(output);
-    return outputJstring;
+/**
+ * Returns byte of the key of the enum value by getter (NULL means the key has only one byte)
+ */
+unsigned char get_enum_key(JNIEnv *env, jobject item, jmethodID getter) {
+    if (!getter) return 0;
+    return (unsigned char) (*env) -> CallByteMethod(env, item, getter);
 }
 
 /**
- * It prepares EnumMap from enum class to fast mapping.
+ * It prepares EnumMap from enum class to fast mapping. The key is read by getters (the second one is NULL for
+ * enumerations identified by one byte). The constant UNRECOGNIZED (signature is its type) is not mapped to any key.
  */
-EnumMap* load_enum_map(JNIEnv *env, const char* clazz)
+EnumMap* load_enum_map(JNIEnv *env, const char* clazz, const char* signature, const char* getter1, const char* getter2)
 {
     // construct signature of static method <Enum>.values()
-    char* signature = (char*) __malloc31(
+    char* signature_values = (char*) __malloc31(
         strlen(clazz) +
         strlen(JNI_SIGNATURE_METHOD_NONE_ARRAY_PREFIX) +
         strlen(JNI_SIGNATURE_METHOD_SEMICOLON_SUFFIX) +
         1
     );
-    strcpy(signature, JNI_SIGNATURE_METHOD_NONE_ARRAY_PREFIX);
-    strcat(signature, clazz);
-    strcat(signature, JNI_SIGNATURE_METHOD_SEMICOLON_SUFFIX);
+    strcpy(signature_values, JNI_SIGNATURE_METHOD_NONE_ARRAY_PREFIX);
+    strcat(signature_values, clazz);
+    strcat(signature_values, JNI_SIGNATURE_METHOD_SEMICOLON_SUFFIX);
 
     // call static method <Enum>.values()
     jclass enum_clazz = (*env) -> FindClass(env, clazz);
-    jmethodID method_values = (*env) -> GetStaticMethodID(env, enum_clazz, JNI_METHOD_VALUES, signature);
+    jmethodID method_values = (*env) -> GetStaticMethodID(env, enum_clazz, JNI_METHOD_VALUES, signature_values);
     jobjectArray values = (*env) -> CallStaticObjectMethod(env, enum_clazz, method_values);
+    free(signature_values);
 
-    // find method byte <Enum>.getValue()
-    jmethodID method_get_value = (*env) -> GetMethodID(env, enum_clazz, JNI_METHOD_GET_VALUE, JNI_SIGNATURE_METHOD_NONE_BYTE);
+    // find getters of the key, ie. byte <Enum>.getValue()
+    jmethodID method_key1 = (*env) -> GetMethodID(env, enum_clazz, getter1, JNI_SIGNATURE_METHOD_NONE_BYTE);
+    jmethodID method_key2 = getter2 ? (*env) -> GetMethodID(env, enum_clazz, getter2, JNI_SIGNATURE_METHOD_NONE_BYTE) : NULL;
 
-    // find the highest value
-    jbyte max_value = 0;
+    // find the sentinel of unknown values
+    jfieldID unrecognized_field = (*env) -> GetStaticFieldID(env, enum_clazz, JNI_PROPERTY_UNRECOGNIZED, signature);
+    jobject unrecognized = (*env) -> GetStaticObjectField(env, enum_clazz, unrecognized_field);
+
+    // find the highest values of both bytes of the key
+    int max1 = 0, max2 = 0;
     int count = (*env) -> GetArrayLength(env, values);
     for (int i = 0; i < count; i++) {
-        jclass item = (*env) -> GetObjectArrayElement(env, values, i);
-        jbyte value = (*env) -> CallByteMethod(env, item, method_get_value);
-        if (value > max_value) max_value = value;
+        jobject item = (*env) -> GetObjectArrayElement(env, values, i);
+        if (!(*env) -> IsSameObject(env, item, unrecognized)) {
+            int key1 = get_enum_key(env, item, method_key1);
+            int key2 = get_enum_key(env, item, method_key2);
+            if (key1 > max1) max1 = key1;
+            if (key2 > max2) max2 = key2;
+        }
+        (*env) -> DeleteLocalRef(env, item);
     }
 
     // construct struct EnumMap with empty values
     EnumMap* out = (EnumMap*) __malloc31(sizeof(EnumMap));
-    out -> max_value = (int) max_value;
+    out -> size1 = max1 + 1;
+    out -> size2 = max2 + 1;
     out -> clazz = (*env) -> NewGlobalRef(env, enum_clazz);
     out -> clazzName = clazz;
-    int array_size = (max_value + 1) * sizeof(jobject*);
+    out -> unrecognized = (*env) -> NewGlobalRef(env, unrecognized);
+    int array_size = out -> size1 * out -> size2 * sizeof(jobject);
     out -> values = (jobject*) __malloc31(array_size);
     memset(out -> values, 0, array_size);
 
     // fill values in the array
     for (int i = 0; i < count; i++) {
         jobject item = (*env) -> GetObjectArrayElement(env, values, i);
-        jbyte value = (*env) -> CallByteMethod(env, item, method_get_value);
-        out -> values[value] = (*env) -> NewGlobalRef(env, item);
+        if (!(*env) -> IsSameObject(env, item, unrecognized)) {
+            int key1 = get_enum_key(env, item, method_key1);
+            int key2 = get_enum_key(env, item, method_key2);
+            out -> values[key1 * out -> size2 + key2] = (*env) -> NewGlobalRef(env, item);
+        }
+        (*env) -> DeleteLocalRef(env, item);
     }
 
     return out;
 }
 
 /**
- * Throws UnknownEnumValueException with set values
+ * Throws UnknownEnumValueException with set values (the second byte is used only for keys with two bytes)
  */
-void throw_unknown_enum_value(JNIEnv *env, EnumMap* enum_map, unsigned char value) {
-    jclass exception_clazz = (*env) -> FindClass(env, JNI_CLASS_UNKNOWN_ENUM_VALUE_EXCEPTION);
-    jmethodID constructor = (*env) -> GetMethodID(env, exception_clazz, JNI_METHOD_CONSTRUCTOR, JNI_SIGNATURE_METHOD_ENUM_BYTE_VOID);
-    jobject exception = (*env) -> NewObject(env, exception_clazz, constructor, enum_map -> clazz, (jbyte) value);
-    (*env) -> Throw(env, exception);
+void throw_unknown_enum_value(JNIEnv *env, EnumMap* enum_map, unsigned char key1, unsigned char key2) {
+    jobject exception;
+    if (enum_map -> size2 > 1) {
+        exception = (*env) -> NewObject(env, unknown_enum_value_exception_clazz,
+            unknown_enum_value_exception_protocol_constructor, enum_map -> clazz, (jbyte) key1, (jbyte) key2);
+    } else {
+        exception = (*env) -> NewObject(env, unknown_enum_value_exception_clazz,
+            unknown_enum_value_exception_constructor, enum_map -> clazz, (jbyte) key1);
+    }
+    if (exception) (*env) -> Throw(env, exception);
 }
 
 /**
- * Returns enum value from EnumMap by byte value
+ * Throws IoctlCallException with the result of ioctl
  */
-jobject get_enum(JNIEnv* env, EnumMap* enum_map, unsigned char value) {
-    // check if value is not greather than maximal known, otherwise throw exception
-    if (enum_map -> max_value < value) {
-        throw_unknown_enum_value(env, enum_map, value);
-        return NULL;
+void throw_ioctl_call_exception(JNIEnv *env, int rcIoctl, int errnoValue, int errno2Value) {
+    jobject exception = (*env) -> NewObject(env, ioctl_call_exception_clazz, ioctl_call_exception_constructor,
+        (jint) rcIoctl, (jint) errnoValue, (jint) errno2Value);
+    if (exception) (*env) -> Throw(env, exception);
+}
+
+/**
+ * Returns global reference to the class or NULL if it cannot be found
+ */
+jclass find_global_class(JNIEnv *env, const char* name) {
+    jclass clazz = (*env) -> FindClass(env, name);
+    if (!clazz) return NULL;
+    jclass out = (*env) -> NewGlobalRef(env, clazz);
+    (*env) -> DeleteLocalRef(env, clazz);
+    return out;
+}
+
+/**
+ * Returns enum value from EnumMap by key (key2 is 0 for keys with one byte). If the key is not known, it returns
+ * UNRECOGNIZED in tolerant mode (see AttlsContext.setTolerateUnknownValues), otherwise it throws exception.
+ */
+jobject get_enum(JNIEnv* env, EnumMap* enum_map, unsigned char key1, unsigned char key2) {
+    // check bounds of the key, the value in the array is null if the key is not known at the moment
+    if ((key1 < enum_map -> size1) && (key2 < enum_map -> size2)) {
+        jobject out = enum_map -> values[key1 * enum_map -> size2 + key2];
+        if (out) return out;
     }
 
-    // find the enum, if value is null, it is not known at the moment and throw exception
-    jobject out = enum_map -> values[value];
-    if (!out) {
-        throw_unknown_enum_value(env, enum_map, value);
+    if ((*env) -> GetStaticBooleanField(env, attls_context_clazz, tolerate_unknown_values_field)) {
+        return enum_map -> unrecognized;
     }
-    return out;
+    throw_unknown_enum_value(env, enum_map, key1, key2);
+    return NULL;
+}
+
+int compare_cipher_entry(const void* a, const void* b)
+{
+    return memcmp(((const CipherEntry*) a) -> code, ((const CipherEntry*) b) -> code, 4);
+}
+
+/**
+ * Adds the code (in ASCII, it is converted into EBCDIC) into the table. Codes with a different length are ignored.
+ */
+void add_cipher(JNIEnv *env, CipherTable* table, jstring code, jobject suite)
+{
+    char buffer[4] = {0};
+    if (transcode_get_ebcdic(env, code, buffer, sizeof(buffer)) != table -> code_length) return;
+
+    CipherEntry* entry = table -> entries + table -> count++;
+    memcpy(entry -> code, buffer, 4);
+    entry -> name = (*env) -> NewGlobalRef(env, code);
+    entry -> suite = suite ? (*env) -> NewGlobalRef(env, suite) : NULL;
+}
+
+/**
+ * Builds tables of 2-character and 4-character codes from all values of CipherSuite
+ */
+void load_cipher_tables(JNIEnv *env)
+{
+    jclass clazz = (*env) -> FindClass(env, JNI_CLASS_CIPHER_SUITE);
+    jmethodID method_values = (*env) -> GetStaticMethodID(env, clazz, JNI_METHOD_VALUES, JNI_SIGNATURE_METHOD_NONE_CIPHER_SUITE_ARRAY);
+    jmethodID method_code2 = (*env) -> GetMethodID(env, clazz, JNI_METHOD_GET_CODE_2, JNI_SIGNATURE_METHOD_NONE_STRING);
+    jmethodID method_code4 = (*env) -> GetMethodID(env, clazz, JNI_METHOD_GET_CODE_4, JNI_SIGNATURE_METHOD_NONE_STRING);
+    jobjectArray values = (*env) -> CallStaticObjectMethod(env, clazz, method_values);
+
+    int count = (*env) -> GetArrayLength(env, values);
+    cipher2_table.entries = (CipherEntry*) __malloc31((count + 1) * sizeof(CipherEntry));
+    cipher4_table.entries = (CipherEntry*) __malloc31(count * sizeof(CipherEntry));
+
+    for (int i = 0; i < count; i++) {
+        jobject suite = (*env) -> GetObjectArrayElement(env, values, i);
+        jstring code2 = (*env) -> CallObjectMethod(env, suite, method_code2);
+        jstring code4 = (*env) -> CallObjectMethod(env, suite, method_code4);
+        add_cipher(env, &cipher2_table, code2, suite);
+        add_cipher(env, &cipher4_table, code4, suite);
+        if (code2) (*env) -> DeleteLocalRef(env, code2);
+        (*env) -> DeleteLocalRef(env, code4);
+        (*env) -> DeleteLocalRef(env, suite);
+    }
+
+    // ciphers with 4-character code only have "4X" as 2-character code
+    jstring code4x = (*env) -> NewStringUTF(env, JNI_CIPHER_4X);
+    add_cipher(env, &cipher2_table, code4x, NULL);
+    (*env) -> DeleteLocalRef(env, code4x);
+
+    qsort(cipher2_table.entries, cipher2_table.count, sizeof(CipherEntry), compare_cipher_entry);
+    qsort(cipher4_table.entries, cipher4_table.count, sizeof(CipherEntry), compare_cipher_entry);
+}
+
+/**
+ * Finds the code returned by ioctl (in EBCDIC) in the table, returns NULL if the code is unknown
+ */
+CipherEntry* find_cipher(CipherTable* table, const char* code)
+{
+    CipherEntry key;
+    memset(key.code, 0, 4);
+    memcpy(key.code, code, table -> code_length);
+    return (CipherEntry*) bsearch(&key, table -> entries, table -> count, sizeof(CipherEntry), compare_cipher_entry);
+}
+
+/**
+ * Delete global references of cipher table and free its memory
+ */
+void free_cipher_table(JNIEnv *env, CipherTable* table)
+{
+    for (int i = 0; i < table -> count; i++) {
+        (*env) -> DeleteGlobalRef(env, table -> entries[i].name);
+        if (table -> entries[i].suite) (*env) -> DeleteGlobalRef(env, table -> entries[i].suite);
+    }
+    free(table -> entries);
+    table -> entries = NULL;
+    table -> count = 0;
 }
 
 /**
@@ -307,7 +560,7 @@ jobject get_enum(JNIEnv* env, EnumMap* enum_map, unsigned char value) {
 JNIEnv* getEnv(JavaVM *vm)
 {
     JNIEnv* env;
-    (*vm) -> GetEnv(vm, &env, JNI_VERSION);
+    (*vm) -> GetEnv(vm, (void**) &env, JNI_VERSION);
     return env;
 }
 
@@ -320,21 +573,33 @@ jint JNI_OnLoad(JavaVM *vm, void *reserved)
 {
     JNIEnv* env = getEnv(vm);
 
+    // initialize backend (z/OS services or simulator)
+    if (attls_backend_init()) return JNI_ERR;
+    if (user_id_intern_init()) return JNI_ERR;
+
     // fetch AtllsContext.class
     jclass clazz = (*env) -> FindClass(env, JNI_CLASS_ATTLS_CONTEXT);
     attls_context_clazz = (*env) -> NewGlobalRef(env, clazz);
 
-    // fetch size of certificate length
-    jfieldID buffer_certificate_size_field = (*env) -> GetStaticFieldID(env, clazz, JNI_PROPERTY_BUFFER_CERTIFICATE_LENGTH, JNI_SIGNATURE_PROPERTY_INTEGER);
-    buffer_certificate_size = (*env) -> GetStaticIntField(env, clazz, buffer_certificate_size_field);
+    // fetch limits of certificate buffer
+    jfieldID buffer_certificate_size_field = (*env) -> GetStaticFieldID(env, clazz, JNI_PROPERTY_BUFFER_CERTIFICATE_MIN_LENGTH, JNI_SIGNATURE_PROPERTY_INTEGER);
+    buffer_certificate_min_size = (*env) -> GetStaticIntField(env, clazz, buffer_certificate_size_field);
+    buffer_certificate_size_field = (*env) -> GetStaticFieldID(env, clazz, JNI_PROPERTY_BUFFER_CERTIFICATE_MAX_LENGTH, JNI_SIGNATURE_PROPERTY_INTEGER);
+    buffer_certificate_max_size = (*env) -> GetStaticIntField(env, clazz, buffer_certificate_size_field);
+    buffer_certificate_typical_size = 0;
 
     // fetch all fields to properties of AttlsContext
     always_load_certificate_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_ALWAYS_LOAD_CERTIFICATE, JNI_SIGNATURE_PROPERTY_BOOLEAN);
+    direct_memory_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_DIRECT_MEMORY, JNI_SIGNATURE_PROPERTY_BOOLEAN);
+    cache_certificate_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_CACHE_CERTIFICATE, JNI_SIGNATURE_PROPERTY_BOOLEAN);
     id_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_ID, JNI_SIGNATURE_PROPERTY_INTEGER);
     ioctl_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_IOCTL, JNI_SIGNATURE_PROPERTY_BYTE_ARRAY);
     buffer_certificate_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_BUFFER_CERTIFICATE, JNI_SIGNATURE_PROPERTY_BYTE_ARRAY);
+    ioctl_direct_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_IOCTL_DIRECT, JNI_SIGNATURE_PROPERTY_BYTE_BUFFER);
+    buffer_certificate_direct_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_BUFFER_CERTIFICATE_DIRECT, JNI_SIGNATURE_PROPERTY_BYTE_BUFFER);
     query_loaded_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_QUERY_LOADED, JNI_SIGNATURE_PROPERTY_BOOLEAN);
     certificate_loaded_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_CERTIFICATE_LOADED, JNI_SIGNATURE_PROPERTY_BOOLEAN);
+    connection_stats_key_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_CONNECTION_STATS_KEY, JNI_SIGNATURE_PROPERTY_LONG);
     stat_policy_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_STAT_POLICY_CACHE, JNI_SIGNATURE_PROPERTY_STAT_POLICY);
     stat_conn_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_STAT_CONN_CACHE, JNI_SIGNATURE_PROPERTY_STAT_CONN);
     protocol_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_PROTOCOL_CACHE, JNI_SIGNATURE_PROPERTY_PROTOCOL);
@@ -343,23 +608,52 @@ jint JNI_OnLoad(JavaVM *vm, void *reserved)
     user_id_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_USER_ID_CACHE, JNI_SIGNATURE_PROPERTY_STRING);
     fips140_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_FIPS_140_CACHE, JNI_SIGNATURE_PROPERTY_FIPS_140);
     negotiated_cipher4_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_NEGOTIATED_CIPHER_4_CACHE, JNI_SIGNATURE_PROPERTY_STRING);
+    cipher_suite_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_CIPHER_SUITE_CACHE, JNI_SIGNATURE_PROPERTY_CIPHER_SUITE);
     negotiated_key_share_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_NEGOTIATED_KEY_SHARE_CACHE, JNI_SIGNATURE_PROPERTY_STRING);
     certificate_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_CERTIFICATE_CACHE, JNI_SIGNATURE_PROPERTY_BYTE_ARRAY);
+    certificate_info_cache_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_CERTIFICATE_INFO_CACHE, JNI_SIGNATURE_PROPERTY_CERTIFICATE_INFO);
+    query_future_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_QUERY_FUTURE, JNI_SIGNATURE_PROPERTY_COMPLETABLE_FUTURE);
+    certificate_future_field = (*env) -> GetFieldID(env, clazz, JNI_PROPERTY_CERTIFICATE_FUTURE, JNI_SIGNATURE_PROPERTY_COMPLETABLE_FUTURE);
+    tolerate_unknown_values_field = (*env) -> GetStaticFieldID(env, clazz, JNI_PROPERTY_TOLERATE_UNKNOWN_VALUES, JNI_SIGNATURE_PROPERTY_BOOLEAN);
+
+    // prepare EnumMap for all possible relevant enumerations, Protocol is identified by version and modifier
+    stat_policy_enum_map = load_enum_map(env, JNI_CLASS_STAT_POLICY, JNI_SIGNATURE_PROPERTY_STAT_POLICY, JNI_METHOD_GET_VALUE, NULL);
+    stat_conn_enum_map = load_enum_map(env, JNI_CLASS_STAT_CONN, JNI_SIGNATURE_PROPERTY_STAT_CONN, JNI_METHOD_GET_VALUE, NULL);
+    security_type_enum_map = load_enum_map(env, JNI_CLASS_SECURITY_TYPE, JNI_SIGNATURE_PROPERTY_SECURITY_TYPE, JNI_METHOD_GET_VALUE, NULL);
+    fips140_enum_map = load_enum_map(env, JNI_CLASS_FIPS_140, JNI_SIGNATURE_PROPERTY_FIPS_140, JNI_METHOD_GET_VALUE, NULL);
+    protocol_enum_map = load_enum_map(env, JNI_CLASS_PROTOCOL, JNI_SIGNATURE_PROPERTY_PROTOCOL, JNI_METHOD_GET_VERSION, JNI_METHOD_GET_MOD);
 
-    // prepare EnumMap for all possible relevant enumerations
-    stat_policy_enum_map = load_enum_map(env, JNI_CLASS_STAT_POLICY);
-    stat_conn_enum_map = load_enum_map(env, JNI_CLASS_STAT_CONN);
-    security_type_enum_map = load_enum_map(env, JNI_CLASS_SECURITY_TYPE);
-    fips140_enum_map = load_enum_map(env, JNI_CLASS_FIPS_140);
+    // prepare tables of known ciphers, their codes are returned without conversion
+    load_cipher_tables(env);
+
+    // prepare parsing of certificates
+    if (certificate_info_init(env)) return JNI_ERR;
+
+    // result of mapping of partner certificate (see mapCertificateToUserId)
+    certificate_response_clazz = find_global_class(env, JNI_CLASS_CERTIFICATE_RESPONSE);
+    if (!certificate_response_clazz) return JNI_ERR;
+    certificate_response_constructor = (*env) -> GetMethodID(env, certificate_response_clazz, JNI_METHOD_CONSTRUCTOR, JNI_SIGNATURE_METHOD_STRING_INT_INT_INT_VOID);
+    if (!certificate_response_constructor) return JNI_ERR;
 
-    // fetch Protocol.class and method Protocol.values() - cannot use EnumMap (it has 2 bytes to identify)
-    enum_protocol_clazz = (*env) -> NewGlobalRef(env, (*env) -> FindClass(env, JNI_CLASS_PROTOCOL));
-    protocol_value_of_method_ID = (*env) -> GetStaticMethodID(env, enum_protocol_clazz, JNI_METHOD_VALUE_OF, JNI_SIGNATURE_METHOD_BYTE_BYTE_PROTOCOL);
 
     // find method Arrays.fill for byte array clean up
     arraysClass = (*env) -> NewGlobalRef(env, (*env) -> FindClass(env, JNI_SIGNATURE_ARRAYS));
     arrays_fill_method_ID = (*env) -> GetStaticMethodID(env, arraysClass, JNI_SIGNATURE_ARRAYS_FILL, JNI_SIGNATURE_METHOD_BYTE_ARRAY_BYTE_VOID);
 
+    // find method ByteBuffer.allocateDirect for memory in direct mode
+    byte_buffer_clazz = (*env) -> NewGlobalRef(env, (*env) -> FindClass(env, JNI_CLASS_BYTE_BUFFER));
+    allocate_direct_method_ID = (*env) -> GetStaticMethodID(env, byte_buffer_clazz, JNI_METHOD_ALLOCATE_DIRECT, JNI_SIGNATURE_METHOD_INT_BYTE_BUFFER);
+
+    // resolve exceptions, failures (ie. on ports without AT-TLS) should not look up classes
+    illegal_argument_exception_clazz = find_global_class(env, JNI_CLASS_ILLEGAL_ARGUMENT_EXCEPTION);
+    unknown_enum_value_exception_clazz = find_global_class(env, JNI_CLASS_UNKNOWN_ENUM_VALUE_EXCEPTION);
+    ioctl_call_exception_clazz = find_global_class(env, JNI_CLASS_IOCTL_CALL_EXCEPTION);
+    if (!illegal_argument_exception_clazz || !unknown_enum_value_exception_clazz || !ioctl_call_exception_clazz) return JNI_ERR;
+    unknown_enum_value_exception_constructor = (*env) -> GetMethodID(env, unknown_enum_value_exception_clazz, JNI_METHOD_CONSTRUCTOR, JNI_SIGNATURE_METHOD_CLASS_BYTE_VOID);
+    unknown_enum_value_exception_protocol_constructor = (*env) -> GetMethodID(env, unknown_enum_value_exception_clazz, JNI_METHOD_CONSTRUCTOR, JNI_SIGNATURE_METHOD_CLASS_BYTE_BYTE_VOID);
+    ioctl_call_exception_constructor = (*env) -> GetMethodID(env, ioctl_call_exception_clazz, JNI_METHOD_CONSTRUCTOR, JNI_SIGNATURE_METHOD_INT_INT_INT_VOID);
+    if (!unknown_enum_value_exception_constructor || !unknown_enum_value_exception_protocol_constructor || !ioctl_call_exception_constructor) return JNI_ERR;
+
     return JNI_VERSION;
 }
 
@@ -379,6 +673,40 @@ jboolean isQueryLoaded(JNIEnv *env, jobject obj)
     return (*env) -> GetBooleanField(env, obj, certificate_loaded_field);
 }
 
+/**
+ * Returns true if request and certificate are stored in native memory (direct buffers), otherwise false.
+ */
+jboolean isDirectMemory(JNIEnv *env, jobject obj)
+{
+    return (*env) -> GetBooleanField(env, obj, direct_memory_field);
+}
+
+/**
+ * Returns address of direct buffer stored in the field. If the buffer has not created yet or it is smaller than size,
+ * it allocates a new one with the size. Memory is owned by the buffer, it is freed by GC together with the AttlsContext.
+ */
+void* getDirectBuffer(JNIEnv *env, jobject obj, jfieldID field, int size)
+{
+    jobject buffer = (*env) -> GetObjectField(env, obj, field);
+    if (!buffer || ((*env) -> GetDirectBufferCapacity(env, buffer) < size)) {
+        buffer = (*env) -> CallStaticObjectMethod(env, byte_buffer_clazz, allocate_direct_method_ID, (jint) size);
+        if (!buffer) return NULL;
+        (*env) -> SetObjectField(env, obj, field, buffer);
+    }
+    return (*env) -> GetDirectBufferAddress(env, buffer);
+}
+
+/**
+ * Zeroes memory of direct buffer stored in the field (if exists). Buffer is kept to be reused.
+ */
+void cleanDirectBuffer(JNIEnv *env, jobject obj, jfieldID field)
+{
+    jobject buffer = (*env) -> GetObjectField(env, obj, field);
+    if (!buffer) return;
+
+    memset((*env) -> GetDirectBufferAddress(env, buffer), 0, (size_t) (*env) -> GetDirectBufferCapacity(env, buffer));
+}
+
 /**
  * Creates and returns array to store request and answer of ioctl, it is stored in AttlsContext.ioctl
  */
@@ -391,6 +719,9 @@ jbyteArray createIoctl(JNIEnv *env, jobject obj)
 
 void releaseIoctl(JNIEnv *env, jobject obj, struct TTLS_IOCTL* ioctl)
 {
+    // native memory is not pinned, there is nothing to copy back
+    if (!ioctl || isDirectMemory(env, obj)) return;
+
     if (ioctl->TTLSi_BufferPtr) {
         jbyteArray certArray = (*env) -> GetObjectField(env, obj, buffer_certificate_field);
         (*env) -> ReleaseByteArrayElements(env, certArray, (jbyte*) ioctl->TTLSi_BufferPtr, 0);
@@ -405,6 +736,11 @@ void releaseIoctl(JNIEnv *env, jobject obj, struct TTLS_IOCTL* ioctl)
  */
 struct TTLS_IOCTL* getIoctl(JNIEnv *env, jobject obj)
 {
+    // in direct mode, the address is stable (also TTLSi_BufferPtr is still valid)
+    if (isDirectMemory(env, obj)) {
+        return (struct TTLS_IOCTL*) getDirectBuffer(env, obj, ioctl_direct_field, sizeof(struct TTLS_IOCTL));
+    }
+
     jbyteArray ioctlArray = (*env) -> GetObjectField(env, obj, ioctl_field);
     if (!ioctlArray) ioctlArray = createIoctl(env, obj);
     struct TTLS_IOCTL* output = (struct TTLS_IOCTL*) (*env) -> GetByteArrayElements(env, ioctlArray, 0);
@@ -417,24 +753,118 @@ struct TTLS_IOCTL* getIoctl(JNIEnv *env, jobject obj)
     return output;
 }
 
+/**
+ * Returns the smallest size class (power of two between min and max size of buffer) to store the length.
+ */
+int certificate_size_class(int length)
+{
+    int size = buffer_certificate_min_size;
+    while ((size < length) && (size < buffer_certificate_max_size)) size <<= 1;
+    return size;
+}
+
+/**
+ * Updates typical size of certificate (moving average). It is not synchronized, concurrent updates could just make
+ * the value less precise.
+ */
+void learn_certificate_size(int length)
+{
+    if (length <= 0) return;
+    buffer_certificate_typical_size += (length - buffer_certificate_typical_size) / 8;
+}
+
+/**
+ * Returns size of a new certificate buffer. It is the size class of typical certificate with a reserve of 25 %.
+ */
+int initial_certificate_buffer_size()
+{
+    int typical = buffer_certificate_typical_size;
+    return certificate_size_class(typical + typical / 4);
+}
+
 /**
  * Creates and returns array to store certificate by ioctl, it is stored in AttlsContext.bufferCertificate
  */
-jbyteArray createCertificateBuffer(JNIEnv *env, jobject obj)
+jbyteArray createCertificateBuffer(JNIEnv *env, jobject obj, int size)
 {
-    jbyteArray array = (*env) -> NewByteArray(env, buffer_certificate_size);
+    jbyteArray array = (*env) -> NewByteArray(env, size);
+    if (!array) return NULL;
     (*env) -> SetObjectField(env, obj, buffer_certificate_field, array);
     return array;
 }
 
 /**
- * Returns array for storing a certificate, if it has not created, create new one.
+ * Removes buffer for storing certificate from the request. If heap array was pinned, it is released without copying
+ * back.
+ */
+void unsetCertificateBuffer(JNIEnv *env, jobject obj, struct TTLS_IOCTL* ioc)
+{
+    if (ioc->TTLSi_BufferPtr && !isDirectMemory(env, obj)) {
+        jbyteArray array = (*env) -> GetObjectField(env, obj, buffer_certificate_field);
+        (*env) -> ReleaseByteArrayElements(env, array, (jbyte*) ioc->TTLSi_BufferPtr, JNI_ABORT);
+    }
+    ioc->TTLSi_BufferPtr = NULL;
+    ioc->TTLSi_BufferLen = 0;
+}
+
+/**
+ * Sets buffer for storing a certificate into the request. The buffer has at least the size, if the current one is
+ * smaller (or it has not created yet), create new one. Returns false if the buffer cannot be allocated.
  */
-jbyte* getCertificateBuffer(JNIEnv *env, jobject obj)
+jboolean setCertificateBuffer(JNIEnv *env, jobject obj, struct TTLS_IOCTL* ioc, int size)
 {
+    if (isDirectMemory(env, obj)) {
+        ioc->TTLSi_BufferPtr = (char*) getDirectBuffer(env, obj, buffer_certificate_direct_field, size);
+        if (!ioc->TTLSi_BufferPtr) return JNI_FALSE;
+        jobject buffer = (*env) -> GetObjectField(env, obj, buffer_certificate_direct_field);
+        ioc->TTLSi_BufferLen = (int) (*env) -> GetDirectBufferCapacity(env, buffer);
+        return JNI_TRUE;
+    }
+
     jbyteArray array = (*env) -> GetObjectField(env, obj, buffer_certificate_field);
-    if (!array) array = createCertificateBuffer(env, obj);
-    return (*env) -> GetByteArrayElements(env, array, 0);
+    if (array && ((*env) -> GetArrayLength(env, array) >= size)) {
+        // array is big enough, pin it if it is not pinned yet (see getIoctl)
+        if (!ioc->TTLSi_BufferPtr) ioc->TTLSi_BufferPtr = (char*) (*env) -> GetByteArrayElements(env, array, 0);
+        ioc->TTLSi_BufferLen = (*env) -> GetArrayLength(env, array);
+        return JNI_TRUE;
+    }
+
+    unsetCertificateBuffer(env, obj, ioc);
+    array = createCertificateBuffer(env, obj, size);
+    if (!array) return JNI_FALSE;
+    ioc->TTLSi_BufferPtr = (char*) (*env) -> GetByteArrayElements(env, array, 0);
+    ioc->TTLSi_BufferLen = size;
+    return JNI_TRUE;
+}
+
+/**
+ * Returns size of buffer to fetch certificate again if the previous call of ioctl reported, that the buffer was too
+ * small. Otherwise it returns 0.
+ */
+int truncated_certificate_size(struct TTLS_IOCTL* ioc, int rcIoctl)
+{
+    if ((rcIoctl < 0) && (errno != ENOBUFS)) return 0;
+    if ((rcIoctl >= 0) && (ioc->TTLSi_Cert_Len <= ioc->TTLSi_BufferLen)) return 0;
+    if (ioc->TTLSi_BufferLen >= buffer_certificate_max_size) return 0;
+
+    // length could be missing in case of error, try the next size class
+    if (ioc->TTLSi_Cert_Len > ioc->TTLSi_BufferLen) return certificate_size_class(ioc->TTLSi_Cert_Len);
+    return certificate_size_class(ioc->TTLSi_BufferLen + 1);
+}
+
+/**
+ * Calls ioctl and records its duration and result into metrics of the operation. It keeps errno of ioctl.
+ */
+int metered_ioctl(int socket, struct TTLS_IOCTL* ioc, int operation)
+{
+    metrics_counter start = metrics_now();
+    int rcIoctl = attls_backend_ioctl(socket, ioc);
+    if (rcIoctl < 0) {
+        metrics_record(&metrics, operation, start, 1, errno, attls_backend_errno2());
+    } else {
+        metrics_record(&metrics, operation, start, 0, 0, 0);
+    }
+    return rcIoctl;
 }
 
 /**
@@ -444,43 +874,171 @@ int getSocket(JNIEnv *env, jobject obj) {
     return (*env) -> GetIntField(env, obj, id_field);
 }
 
+/**
+ * Evaluates the probe of query version (see query_version). Returns 1 if the request should be repeated with version 1.
+ */
+int probe_query_version(struct TTLS_IOCTL* ioc, int rcIoctl)
+{
+    if (query_version != QUERY_VERSION_UNKNOWN) return 0;
+    if (ioc->TTLSi_Req_Type & ~(TTLS_QUERY_ONLY | TTLS_RETURN_CERTIFICATE)) return 0;
+
+    if (rcIoctl >= 0) {
+        query_version = ioc->TTLSi_Ver;
+        return 0;
+    }
+    if ((errno == EINVAL) && (ioc->TTLSi_Ver == TTLS_VERSION2)) {
+        ioc->TTLSi_Ver = TTLS_VERSION1;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Probes the query version by a plain query (see query_version). It is called before the first command combined with
+ * query, so the command is sent with the right version and its failure cannot switch the version.
+ */
+void probe_query_version_by_query(JNIEnv *env, jobject obj, struct TTLS_IOCTL* ioc)
+{
+    ioc->TTLSi_Ver = TTLS_VERSION2;
+    ioc->TTLSi_Req_Type = TTLS_QUERY_ONLY;
+    unsetCertificateBuffer(env, obj, ioc);
+
+    int rcIoctl;
+    do {
+        rcIoctl = metered_ioctl(getSocket(env, obj), ioc, METRICS_QUERY);
+    } while (probe_query_version(ioc, rcIoctl));
+}
+
+/**
+ * Returns numeric code of cipher from its hexadecimal code in EBCDIC or STATS_NO_CIPHER if it is not a valid code
+ */
+int parse_cipher_code(const char* code, int length)
+{
+    jchar chars[4];
+    if (transcode_ebcdic_to_utf16(code, length, chars) != length) return STATS_NO_CIPHER;
+
+    int value = 0;
+    for (int i = 0; i < length; i++) {
+        jchar c = chars[i];
+        if ((c >= '0') && (c <= '9')) value = value * 16 + (c - '0');
+        else if ((c >= 'A') && (c <= 'F')) value = value * 16 + (c - 'A' + 10);
+        else return STATS_NO_CIPHER;
+    }
+    return value;
+}
+
+/**
+ * Counts the result of query into connection_stats. A context is counted once, values of its previous query are
+ * replaced (see AttlsContext.connectionStatsKey). The cipher is taken from the 4-character code, older stacks could
+ * return only the 2-character one.
+ */
+void record_connection_stats(JNIEnv *env, jobject obj, struct TTLS_IOCTL* ioc)
+{
+    int cipher = parse_cipher_code(ioc->TTLSi_Neg_Cipher4, 4);
+    if (cipher == STATS_NO_CIPHER) cipher = parse_cipher_code(ioc->TTLSi_Neg_Cipher, 2);
+
+    stats_remove(&connection_stats, (*env) -> GetLongField(env, obj, connection_stats_key_field));
+    stats_key key = stats_add(&connection_stats, getSocket(env, obj), ioc->TTLSi_Stat_Policy, ioc->TTLSi_Stat_Conn,
+        ioc->TTLSi_SSL_Protocol.Prot_bytes.Prot_Ver, ioc->TTLSi_SSL_Protocol.Prot_bytes.Prot_Mod,
+        ioc->TTLSi_FIPS140, cipher);
+    (*env) -> SetLongField(env, obj, connection_stats_key_field, key);
+}
+
 /**
  * It call ioctl to fetch query or certificate. Type of call is determinated by arguments query and certificate.
- * Also in the case alwaysLoadCertificate is set to true certificated is fetched.
+ * Also in the case alwaysLoadCertificate is set to true certificated is fetched. The result of ioctl is stored into
+ * rcIoctl (errno is kept), it does not throw any exception about failed ioctl.
+ *
+ * If command is set (ie. TTLS_INIT_CONNECTION), it is sent in the same request and the call is measured as operation.
+ * When the certificate does not fit into the buffer, the request is repeated only as a query, the command is not
+ * issued twice.
  */
-struct TTLS_IOCTL* load(JNIEnv *env, jobject obj, jboolean certificate)
+struct TTLS_IOCTL* load_command_status(JNIEnv *env, jobject obj, int command, int operation, jboolean certificate,
+    int* rcOut)
 {
+    *rcOut = 0;
+
     // get struct of request
     struct TTLS_IOCTL* ioc = getIoctl(env, obj);
+    if (!ioc) return NULL;
 
-    // construct request
-
-    ioc->TTLSi_Ver = TTLS_VERSION1;
+    // construct request, version 2 is used until the probe finds it is not supported
+    if (command && (query_version == QUERY_VERSION_UNKNOWN)) probe_query_version_by_query(env, obj, ioc);
+    int version = query_version;
+    ioc->TTLSi_Ver = (version == QUERY_VERSION_UNKNOWN) ? TTLS_VERSION2 : version;
 
     if (!certificate) {
         certificate |= (*env) -> GetBooleanField(env, obj, always_load_certificate_field);
     }
-    ioc->TTLSi_Req_Type = TTLS_QUERY_ONLY;
+    ioc->TTLSi_Req_Type = command | TTLS_QUERY_ONLY;
     if (certificate) ioc->TTLSi_Req_Type |= TTLS_RETURN_CERTIFICATE;
+    if (!command) operation = certificate ? METRICS_QUERY_CERTIFICATE : METRICS_QUERY;
+
+    if (!certificate) {
+        unsetCertificateBuffer(env, obj, ioc);
+    } else if (!setCertificateBuffer(env, obj, ioc, initial_certificate_buffer_size())) {
+        return ioc;
+    }
 
-    ioc->TTLSi_BufferPtr = certificate ? (char*) getCertificateBuffer(env, obj) : (char*) NULL;
-    ioc->TTLSi_BufferLen = certificate ? buffer_certificate_size : 0;
+    // call ioctl, if certificate does not fit into the buffer, repeat it with a bigger one
+    int rcIoctl;
+    for (;;) {
+        rcIoctl = metered_ioctl(getSocket(env, obj), ioc, operation);
+        if (probe_query_version(ioc, rcIoctl)) continue;
+        if (!certificate) break;
 
-    // call ioctl
-    int rcIoctl = ioctl(getSocket(env, obj), SIOCTTLSCTL, (char*) ioc);
+        int size = truncated_certificate_size(ioc, rcIoctl);
+        if (!size) break;
+        if (!setCertificateBuffer(env, obj, ioc, size)) return ioc;
 
-    // if ioctl returns an error throw exception
-    if (rcIoctl < 0) {
-        jclass exception_clazz = (*env) -> FindClass(env, JNI_CLASS_IOCTL_CALL_EXCEPTION);
-        jmethodID constructor = (*env) -> GetMethodID(env, exception_clazz, JNI_METHOD_CONSTRUCTOR, JNI_SIGNATURE_METHOD_INT_INT_INT_VOID);
-        jobject exception = (*env) -> NewObject(env, exception_clazz, constructor,
-            (jint) rcIoctl, (jint) errno, (jint) __errno2());
-        (*env) -> Throw(env, exception);
+        // the command was processed, repeat only the query
+        ioc->TTLSi_Req_Type = TTLS_QUERY_ONLY | TTLS_RETURN_CERTIFICATE;
+        operation = METRICS_QUERY_CERTIFICATE;
+    }
+
+    *rcOut = rcIoctl;
+    if (rcIoctl < 0) return ioc;
+    record_connection_stats(env, obj, ioc);
+
+    // mark data as loaded, next calls will use them without a new call of ioctl
+    (*env) -> SetBooleanField(env, obj, query_loaded_field, JNI_TRUE);
+    if (certificate) {
+        (*env) -> SetBooleanField(env, obj, certificate_loaded_field, JNI_TRUE);
+        learn_certificate_size(ioc->TTLSi_Cert_Len);
     }
 
     return ioc;
 }
 
+/**
+ * The same as load_command_status without any command
+ */
+struct TTLS_IOCTL* load_status(JNIEnv *env, jobject obj, jboolean certificate, int* rcOut)
+{
+    return load_command_status(env, obj, 0, METRICS_QUERY, certificate, rcOut);
+}
+
+/**
+ * The same as load_command_status, but if ioctl returns an error it throws IoctlCallException.
+ */
+struct TTLS_IOCTL* load_command(JNIEnv *env, jobject obj, int command, int operation, jboolean certificate)
+{
+    int rcIoctl;
+    struct TTLS_IOCTL* ioc = load_command_status(env, obj, command, operation, certificate, &rcIoctl);
+    if (rcIoctl < 0) {
+        throw_ioctl_call_exception(env, rcIoctl, errno, attls_backend_errno2());
+    }
+    return ioc;
+}
+
+/**
+ * The same as load_status, but if ioctl returns an error it throws IoctlCallException.
+ */
+struct TTLS_IOCTL* load(JNIEnv *env, jobject obj, jboolean certificate)
+{
+    return load_command(env, obj, 0, METRICS_QUERY, certificate);
+}
+
 /**
  * Return ioctl with data from query call. If data are available in memory, returns them, otherwise call ioctl.
  * If alwaysLoadCertificate is set to true certificated is also fetched.
@@ -508,10 +1066,15 @@ void cleanByteArray(JNIEnv *env, jbyteArray arr)
 }
 
 /**
- * Clean state of AttlsContext. It remove all cached data. Next call will fetch new one.
+ * Clean state of AttlsContext. It remove all cached data. Next call will fetch new one. If keepBuffers is set, the
+ * request and the certificate buffer on heap are only zeroed and kept to be reused (see reset).
  */
-JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_clean(JNIEnv *env, jobject obj)
+void clean_context(JNIEnv *env, jobject obj, jboolean keepBuffers)
 {
+    // the connection is not counted in connection_stats until the next query
+    stats_remove(&connection_stats, (*env) -> GetLongField(env, obj, connection_stats_key_field));
+    (*env) -> SetLongField(env, obj, connection_stats_key_field, 0);
+
     // clean flags about loaded data
     (*env) -> SetBooleanField(env, obj, query_loaded_field, JNI_FALSE);
     (*env) -> SetBooleanField(env, obj, certificate_loaded_field, JNI_FALSE);
@@ -521,9 +1084,15 @@ JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_clean(JNIEnv *en
      cleanByteArray(env, (*env) -> GetObjectField(env, obj, buffer_certificate_field));
      cleanByteArray(env, (*env) -> GetObjectField(env, obj, certificate_cache_field));
 
+    // clean native memory, direct buffers are kept to be reused
+    cleanDirectBuffer(env, obj, ioctl_direct_field);
+    cleanDirectBuffer(env, obj, buffer_certificate_direct_field);
+
     // clean all cached values (Java objects)
-    (*env) -> SetObjectField(env, obj, ioctl_field, NULL);
-    (*env) -> SetObjectField(env, obj, buffer_certificate_field, NULL);
+    if (!keepBuffers) {
+        (*env) -> SetObjectField(env, obj, ioctl_field, NULL);
+        (*env) -> SetObjectField(env, obj, buffer_certificate_field, NULL);
+    }
     (*env) -> SetObjectField(env, obj, stat_policy_cache_field, NULL);
     (*env) -> SetObjectField(env, obj, stat_conn_cache_field, NULL);
     (*env) -> SetObjectField(env, obj, protocol_cache_field, NULL);
@@ -532,8 +1101,32 @@ JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_clean(JNIEnv *en
     (*env) -> SetObjectField(env, obj, user_id_cache_field, NULL);
     (*env) -> SetObjectField(env, obj, fips140_cache_field, NULL);
     (*env) -> SetObjectField(env, obj, negotiated_cipher4_cache_field, NULL);
+    (*env) -> SetObjectField(env, obj, cipher_suite_cache_field, NULL);
     (*env) -> SetObjectField(env, obj, negotiated_key_share_cache_field, NULL);
     (*env) -> SetObjectField(env, obj, certificate_cache_field, NULL);
+    (*env) -> SetObjectField(env, obj, certificate_info_cache_field, NULL);
+
+    // next asynchronous calls will fetch new data
+    (*env) -> SetObjectField(env, obj, query_future_field, NULL);
+    (*env) -> SetObjectField(env, obj, certificate_future_field, NULL);
+}
+
+/**
+ * Clean state of AttlsContext. It remove all cached data. Next call will fetch new one.
+ */
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_cleanNative(JNIEnv *env, jobject obj)
+{
+    clean_context(env, obj, JNI_FALSE);
+}
+
+/**
+ * Prepare AttlsContext for another socket. All cached data are removed, but buffers are zeroed and kept, so the
+ * context could be reused without any allocation.
+ */
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_resetNative(JNIEnv *env, jobject obj, jint id)
+{
+    clean_context(env, obj, JNI_TRUE);
+    (*env) -> SetIntField(env, obj, id_field, id);
 }
 
 /**
@@ -550,7 +1143,7 @@ JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getStatPolicy
         return NULL;
     }
 
-    out = get_enum(env, stat_policy_enum_map, ioctl->TTLSi_Stat_Policy);
+    out = get_enum(env, stat_policy_enum_map, ioctl->TTLSi_Stat_Policy, 0);
     if ((*env) -> ExceptionCheck(env)) {
         releaseIoctl(env, obj, ioctl);
         return NULL;
@@ -575,7 +1168,7 @@ JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getStatConn(J
       return NULL;
     }
 
-    out = get_enum(env, stat_conn_enum_map, ioctl->TTLSi_Stat_Conn);
+    out = get_enum(env, stat_conn_enum_map, ioctl->TTLSi_Stat_Conn, 0);
     if ((*env) -> ExceptionCheck(env)) {
       releaseIoctl(env, obj, ioctl);
       return NULL;
@@ -600,19 +1193,10 @@ JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getProtocol(J
          return NULL;
     }
 
-    // call static method Protocol.valueOf(byte, byte)
-    out = (*env) -> CallStaticObjectMethod(env, enum_protocol_clazz, protocol_value_of_method_ID,
-        (jbyte) ioctl->TTLSi_SSL_Protocol.Prot_bytes.Prot_Ver,
-        (jbyte) ioctl->TTLSi_SSL_Protocol.Prot_bytes.Prot_Mod);
-    if (!out)
-    {
-        // if enum was not fetched, throw exception
-        jclass exception_clazz = (*env) -> FindClass(env, JNI_CLASS_UNKNOWN_ENUM_VALUE_EXCEPTION);
-        jmethodID constructor = (*env) -> GetMethodID(env, exception_clazz, JNI_METHOD_CONSTRUCTOR, JNI_SIGNATURE_METHOD_ENUM_BYTE_BYTE_VOID);
-        jobject exception = (*env) -> NewObject(env, exception_clazz, constructor, enum_protocol_clazz,
-            (jbyte) ioctl->TTLSi_SSL_Protocol.Prot_bytes.Prot_Ver,
-            (jbyte) ioctl->TTLSi_SSL_Protocol.Prot_bytes.Prot_Mod);
-        (*env) -> Throw(env, exception);
+    out = get_enum(env, protocol_enum_map,
+        ioctl->TTLSi_SSL_Protocol.Prot_bytes.Prot_Ver,
+        ioctl->TTLSi_SSL_Protocol.Prot_bytes.Prot_Mod);
+    if ((*env) -> ExceptionCheck(env)) {
         releaseIoctl(env, obj, ioctl);
         return NULL;
     }
@@ -636,7 +1220,8 @@ JNIEXPORT jstring JNICALL Java_org_zowe_commons_attls_AttlsContext_getNegotiated
         return NULL;
     }
 
-    out = get_jstring(env, ioctl->TTLSi_Neg_Cipher, 2);
+    CipherEntry* cipher = find_cipher(&cipher2_table, ioctl->TTLSi_Neg_Cipher);
+    out = cipher ? (*env) -> NewLocalRef(env, cipher -> name) : get_jstring(env, ioctl->TTLSi_Neg_Cipher, 2);
     if ((*env) -> ExceptionCheck(env)) {
       releaseIoctl(env, obj, ioctl);
       return NULL;
@@ -660,7 +1245,7 @@ JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getSecurityTy
     return NULL;
     }
 
-    out = get_enum(env, security_type_enum_map, ioctl->TTLSi_Sec_Type);
+    out = get_enum(env, security_type_enum_map, ioctl->TTLSi_Sec_Type, 0);
     if ((*env) -> ExceptionCheck(env)) {
     releaseIoctl(env, obj, ioctl);
     return NULL;
@@ -685,7 +1270,9 @@ JNIEXPORT jstring JNICALL Java_org_zowe_commons_attls_AttlsContext_getUserId(JNI
     return NULL;
     }
 
-    out = get_jstring(env, ioctl->TTLSi_UserID, ioctl->TTLSi_UserID_Len);
+    // user IDs repeat across connections, the interned string is shared (see userIdIntern.h)
+    out = user_id_intern(env, ioctl->TTLSi_UserID, ioctl->TTLSi_UserID_Len);
+    if (!out) out = get_jstring(env, ioctl->TTLSi_UserID, ioctl->TTLSi_UserID_Len);
     if ((*env) -> ExceptionCheck(env)) {
     releaseIoctl(env, obj, ioctl);
     return NULL;
@@ -710,7 +1297,7 @@ JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getFips140(JN
     return NULL;
     }
 
-    out = get_enum(env, fips140_enum_map, ioctl->TTLSi_FIPS140);
+    out = get_enum(env, fips140_enum_map, ioctl->TTLSi_FIPS140, 0);
     if ((*env) -> ExceptionCheck(env)) {
     releaseIoctl(env, obj, ioctl);
     return NULL;
@@ -734,7 +1321,7 @@ JNIEXPORT jbyte JNICALL Java_org_zowe_commons_attls_AttlsContext_getFlags(JNIEnv
 
     jbyte out = (jbyte) ioctl->TTLSi_Flags;
     releaseIoctl(env, obj, ioctl);
-    return (jbyte) ioctl->TTLSi_Flags;
+    return out;
 }
 
 /**
@@ -751,7 +1338,8 @@ JNIEXPORT jstring JNICALL Java_org_zowe_commons_attls_AttlsContext_getNegotiated
     return NULL;
     }
 
-    out = get_jstring(env, ioctl->TTLSi_Neg_Cipher4, 4);
+    CipherEntry* cipher = find_cipher(&cipher4_table, ioctl->TTLSi_Neg_Cipher4);
+    out = cipher ? (*env) -> NewLocalRef(env, cipher -> name) : get_jstring(env, ioctl->TTLSi_Neg_Cipher4, 4);
     if ((*env) -> ExceptionCheck(env)) {
      releaseIoctl(env, obj, ioctl);
      return NULL;
@@ -762,14 +1350,149 @@ JNIEXPORT jstring JNICALL Java_org_zowe_commons_attls_AttlsContext_getNegotiated
     return out;
 }
 
+/**
+ * Return or load and cache value AttlsContext.negotiatedKeyShareCache. It returns NULL if the value is not available
+ * (the request has version 1 or the connection does not use TLSv1.3).
+ */
+JNIEXPORT jstring JNICALL Java_org_zowe_commons_attls_AttlsContext_getNegotiatedKeyShare(JNIEnv *env, jobject obj)
+{
+    jstring out = (*env) -> GetObjectField(env, obj, negotiated_key_share_cache_field);
+    if (out) return out;
 
+    struct TTLS_IOCTL* ioctl = requireQuery(env, obj);
+    if ((*env) -> ExceptionCheck(env) || (ioctl->TTLSi_Ver < TTLS_VERSION2) || !ioctl->TTLSi_Neg_KeyShare[0]) {
+        releaseIoctl(env, obj, ioctl);
+        return NULL;
+    }
+
+    out = get_jstring(env, ioctl->TTLSi_Neg_KeyShare, 4);
+    if ((*env) -> ExceptionCheck(env)) {
+        releaseIoctl(env, obj, ioctl);
+        return NULL;
+    }
+
+    (*env) -> SetObjectField(env, obj, negotiated_key_share_cache_field, out);
+    releaseIoctl(env, obj, ioctl);
+    return out;
+}
+
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_getQueryVersion(JNIEnv *env, jclass clazz)
+{
+    return query_version;
+}
 
 /**
- * Return or load and cache value AttlsContext.certificateCache
+ * Return or load and cache value AttlsContext.cipherSuiteCache. It returns NULL for an unknown cipher.
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getCipherSuite(JNIEnv *env, jobject obj)
+{
+    jobject out = (*env) -> GetObjectField(env, obj, cipher_suite_cache_field);
+    if (out) return out;
+
+    struct TTLS_IOCTL* ioctl = requireQuery(env, obj);
+    if ((*env) -> ExceptionCheck(env)) {
+        releaseIoctl(env, obj, ioctl);
+        return NULL;
+    }
+
+    CipherEntry* cipher = find_cipher(&cipher4_table, ioctl->TTLSi_Neg_Cipher4);
+    if (!cipher || !cipher -> suite) cipher = find_cipher(&cipher2_table, ioctl->TTLSi_Neg_Cipher);
+    if (cipher && cipher -> suite) {
+        out = (*env) -> NewLocalRef(env, cipher -> suite);
+        (*env) -> SetObjectField(env, obj, cipher_suite_cache_field, out);
+    }
+
+    releaseIoctl(env, obj, ioctl);
+    return out;
+}
+
+/**
+ * Return all primitive values of query packed into one long (see PackedStatus.java). It does not create any Java object
+ * and all values are fetched by just one call.
+ */
+jlong pack_status(struct TTLS_IOCTL* ioctl)
+{
+    return PACKED_STATUS_BYTE(ioctl->TTLSi_Stat_Policy, PACKED_STATUS_STAT_POLICY_SHIFT) |
+        PACKED_STATUS_BYTE(ioctl->TTLSi_Stat_Conn, PACKED_STATUS_STAT_CONN_SHIFT) |
+        PACKED_STATUS_BYTE(ioctl->TTLSi_SSL_Protocol.Prot_bytes.Prot_Ver, PACKED_STATUS_PROTOCOL_VERSION_SHIFT) |
+        PACKED_STATUS_BYTE(ioctl->TTLSi_SSL_Protocol.Prot_bytes.Prot_Mod, PACKED_STATUS_PROTOCOL_MOD_SHIFT) |
+        PACKED_STATUS_BYTE(ioctl->TTLSi_Sec_Type, PACKED_STATUS_SECURITY_TYPE_SHIFT) |
+        PACKED_STATUS_BYTE(ioctl->TTLSi_FIPS140, PACKED_STATUS_FIPS_140_SHIFT) |
+        PACKED_STATUS_BYTE(ioctl->TTLSi_Flags, PACKED_STATUS_FLAGS_SHIFT) |
+        PACKED_STATUS_BYTE(strnlen(ioctl->TTLSi_UserID, ioctl->TTLSi_UserID_Len), PACKED_STATUS_USER_ID_LENGTH_SHIFT);
+}
+
+JNIEXPORT jlong JNICALL Java_org_zowe_commons_attls_AttlsContext_getPackedStatus(JNIEnv *env, jobject obj)
+{
+    struct TTLS_IOCTL* ioctl = requireQuery(env, obj);
+    if ((*env) -> ExceptionCheck(env)) {
+        releaseIoctl(env, obj, ioctl);
+        return 0;
+    }
+
+    jlong out = pack_status(ioctl);
+    releaseIoctl(env, obj, ioctl);
+    return out;
+}
+
+/**
+ * Query without exceptions about ioctl. On success it stores packed status into status[0] and returns 0. If ioctl
+ * fails, it returns errno (or -1 if errno is not set) and stores errno2 into status[1]. The array could be shorter or
+ * null, then the values are not stored.
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_tryQuery(JNIEnv *env, jobject obj, jlongArray status)
+{
+    jlong values[2] = {0, 0};
+    jint rc = 0;
+
+    struct TTLS_IOCTL* ioctl;
+    if (isQueryLoaded(env, obj)) {
+        ioctl = getIoctl(env, obj);
+    } else {
+        int rcIoctl;
+        ioctl = load_status(env, obj, JNI_FALSE, &rcIoctl);
+        if (rcIoctl < 0) {
+            rc = errno ? errno : -1;
+            values[1] = attls_backend_errno2();
+        }
+    }
+
+    // the only possible exceptions are about memory (allocation of request or buffers)
+    if ((*env) -> ExceptionCheck(env)) {
+        releaseIoctl(env, obj, ioctl);
+        return -1;
+    }
+
+    if (!rc && ioctl) values[0] = pack_status(ioctl);
+    releaseIoctl(env, obj, ioctl);
+
+    if (status) {
+        int length = (*env) -> GetArrayLength(env, status);
+        if (length > 2) length = 2;
+        (*env) -> SetLongArrayRegion(env, status, 0, length, values);
+    }
+    return rc;
+}
+
+/**
+ * Returns length of certificate in the buffer. It could be truncated only if it is bigger than the biggest buffer.
+ */
+int get_certificate_length(struct TTLS_IOCTL* ioctl)
+{
+    int length = ioctl->TTLSi_Cert_Len;
+    if (length > ioctl->TTLSi_BufferLen) length = ioctl->TTLSi_BufferLen;
+    if ((length < 0) || !ioctl->TTLSi_BufferPtr) length = 0;
+    return length;
+}
+
+/**
+ * Return or load and cache value AttlsContext.certificateCache. If AttlsContext.cacheCertificate is false, the array
+ * is not stored and each call creates a new one.
  */
 JNIEXPORT jbyteArray JNICALL Java_org_zowe_commons_attls_AttlsContext_getCertificate(JNIEnv *env, jobject obj)
 {
-    jbyteArray out = (*env) -> GetObjectField(env, obj, certificate_cache_field);
+    jboolean cache = (*env) -> GetBooleanField(env, obj, cache_certificate_field);
+    jbyteArray out = cache ? (*env) -> GetObjectField(env, obj, certificate_cache_field) : NULL;
     if (out) return out;
 
     struct TTLS_IOCTL* ioctl = requireCertificate(env, obj);
@@ -778,63 +1501,262 @@ JNIEXPORT jbyteArray JNICALL Java_org_zowe_commons_attls_AttlsContext_getCertifi
     return NULL;
     }
 
-    out = (*env) -> NewByteArray(env, ioctl->TTLSi_Cert_Len);
-    (*env) -> SetByteArrayRegion(env, out, 0, ioctl->TTLSi_Cert_Len, ioctl->TTLSi_BufferPtr);
+    int length = get_certificate_length(ioctl);
+    out = (*env) -> NewByteArray(env, length);
+    if (out) {
+        (*env) -> SetByteArrayRegion(env, out, 0, length, ioctl->TTLSi_BufferPtr);
+        if (cache) (*env) -> SetObjectField(env, obj, certificate_cache_field, out);
+    }
 
-    (*env) -> SetObjectField(env, obj, certificate_cache_field, out);
     releaseIoctl(env, obj, ioctl);
     return out;
 }
 
+/**
+ * Copies certificate into the caller's memory: to array (if set) or to address. Nothing is copied if the certificate
+ * is bigger than capacity. It returns length of certificate, AttlsContext.certificateCache is not used.
+ */
+jint copy_certificate(JNIEnv *env, jobject obj, jbyteArray array, jbyte* address, jint offset, jint capacity)
+{
+    struct TTLS_IOCTL* ioctl = requireCertificate(env, obj);
+    if ((*env) -> ExceptionCheck(env)) {
+        releaseIoctl(env, obj, ioctl);
+        return 0;
+    }
+
+    int length = get_certificate_length(ioctl);
+    if ((length > 0) && (length <= capacity)) {
+        if (array) {
+            (*env) -> SetByteArrayRegion(env, array, offset, length, ioctl->TTLSi_BufferPtr);
+        } else {
+            memcpy(address + offset, ioctl->TTLSi_BufferPtr, length);
+        }
+    }
+
+    releaseIoctl(env, obj, ioctl);
+    return length;
+}
+
+/**
+ * Copies certificate into the array from offset if it is not longer than length
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_copyCertificate(JNIEnv *env, jobject obj, jbyteArray dst, jint offset, jint length)
+{
+    if (!dst || (offset < 0) || (length < 0) || (offset > (*env) -> GetArrayLength(env, dst) - length)) {
+        (*env) -> ThrowNew(env, illegal_argument_exception_clazz, JNI_MESSAGE_OUT_OF_BUFFER);
+        return 0;
+    }
+    return copy_certificate(env, obj, dst, NULL, offset, length);
+}
+
+/**
+ * Copies certificate into the direct buffer from offset if it is not longer than length
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_copyCertificateDirect(JNIEnv *env, jobject obj, jobject dst, jint offset, jint length)
+{
+    jbyte* address = dst ? (jbyte*) (*env) -> GetDirectBufferAddress(env, dst) : NULL;
+    if (!address || (offset < 0) || (length < 0) || (offset > (*env) -> GetDirectBufferCapacity(env, dst) - length)) {
+        (*env) -> ThrowNew(env, illegal_argument_exception_clazz, JNI_MESSAGE_OUT_OF_BUFFER);
+        return 0;
+    }
+    return copy_certificate(env, obj, NULL, address, offset, length);
+}
+
+/**
+ * Return or load and cache value AttlsContext.certificateInfoCache. Fields are read directly from the certificate
+ * buffer, no copy of the certificate is created. It returns NULL if there is no partner certificate.
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getCertificateInfo(JNIEnv *env, jobject obj)
+{
+    jobject out = (*env) -> GetObjectField(env, obj, certificate_info_cache_field);
+    if (out) return out;
+
+    struct TTLS_IOCTL* ioctl = requireCertificate(env, obj);
+    if ((*env) -> ExceptionCheck(env)) {
+        releaseIoctl(env, obj, ioctl);
+        return NULL;
+    }
+
+    int length = get_certificate_length(ioctl);
+    if (length > 0) {
+        out = certificate_info_create(env, (const unsigned char*) ioctl->TTLSi_BufferPtr, length);
+        if (out) (*env) -> SetObjectField(env, obj, certificate_info_cache_field, out);
+    }
+
+    releaseIoctl(env, obj, ioctl);
+    return out;
+}
+
+/**
+ * Returns partner user ID from the ioctl (mapped by AT-TLS) or NULL if it is not set
+ */
+jstring get_partner_user_id(JNIEnv *env, struct TTLS_IOCTL* ioctl)
+{
+    int length = strnlen(ioctl->TTLSi_UserID, ioctl->TTLSi_UserID_Len);
+    if (length <= 0) return NULL;
+
+    jstring out = user_id_intern(env, ioctl->TTLSi_UserID, length);
+    if (!out) out = get_jstring(env, ioctl->TTLSi_UserID, length);
+    return out;
+}
+
+/**
+ * Maps partner certificate to user ID. If AT-TLS has already mapped the user ID, it is returned without calling SAF.
+ * Otherwise the certificate buffer is passed directly to __certificate, no copy on Java heap is created.
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_mapCertificateToUserId(JNIEnv *env, jobject obj)
+{
+    struct TTLS_IOCTL* ioctl;
+    jstring userId = NULL;
+
+    // query (with certificate if alwaysLoadCertificate is set) could contain user ID already
+    if (isQueryLoaded(env, obj)) {
+        ioctl = getIoctl(env, obj);
+        if (ioctl) userId = get_partner_user_id(env, ioctl);
+        releaseIoctl(env, obj, ioctl);
+        if ((*env) -> ExceptionCheck(env)) return NULL;
+        if (userId) return (*env) -> NewObject(env, certificate_response_clazz, certificate_response_constructor, userId, 0, 0, 0);
+    }
+
+    // one ioctl fetches both query and certificate
+    ioctl = requireCertificate(env, obj);
+    if ((*env) -> ExceptionCheck(env)) {
+        releaseIoctl(env, obj, ioctl);
+        return NULL;
+    }
+
+    userId = get_partner_user_id(env, ioctl);
+    if ((*env) -> ExceptionCheck(env)) {
+        releaseIoctl(env, obj, ioctl);
+        return NULL;
+    }
+    if (userId) {
+        releaseIoctl(env, obj, ioctl);
+        return (*env) -> NewObject(env, certificate_response_clazz, certificate_response_constructor, userId, 0, 0, 0);
+    }
+
+    char useridRacf[9] = {0};
+    int rc = -1;
+    int errnoValue = EINVAL;
+    int errno2Value = 0;
+
+    int length = get_certificate_length(ioctl);
+    // without partner certificate there is nothing to map, it is reported as EINVAL
+    if (length > 0) {
+        metrics_counter start = metrics_now();
+        rc = attls_backend_map_certificate(length, ioctl->TTLSi_BufferPtr, sizeof(useridRacf), useridRacf);
+        errnoValue = rc ? errno : 0;
+        errno2Value = rc ? attls_backend_errno2() : 0;
+        metrics_record(&metrics, METRICS_MAP_CERTIFICATE, start, rc != 0, errnoValue, errno2Value);
+    }
+    releaseIoctl(env, obj, ioctl);
+
+    // the same values as UserMapper returns (empty user ID on failure)
+    userId = user_id_intern(env, useridRacf, 8);
+    if (!userId) userId = get_jstring(env, useridRacf, 8);
+    if (!userId) return NULL;
+    return (*env) -> NewObject(env, certificate_response_clazz, certificate_response_constructor, userId, rc, errnoValue, errno2Value);
+}
+
 /**
  * This method call ioctl with request type by argument command. It is using to call other request type than query and
  * protocol (They are called via method load).
  */
-void issueCommand(JNIEnv *env, jobject obj, int command)
+void issueCommand(JNIEnv *env, jobject obj, int command, int operation)
 {
     struct TTLS_IOCTL* ioc = getIoctl(env, obj);
+    if (!ioc) return;
 
     ioc->TTLSi_Ver = TTLS_VERSION1;
     ioc->TTLSi_Req_Type = command;
     ioc->TTLSi_BufferPtr = NULL;
     ioc->TTLSi_BufferLen = 0;
 
-    int rcIoctl = ioctl(getSocket(env, obj), SIOCTTLSCTL, (char *) ioc);
-     releaseIoctl(env, obj, ioc);
+    int rcIoctl = metered_ioctl(getSocket(env, obj), ioc, operation);
+    int errnoValue = errno;
+    int errno2Value = attls_backend_errno2();
+    releaseIoctl(env, obj, ioc);
 
     if (rcIoctl < 0) {
-        jclass exception_clazz = (*env) -> FindClass(env, JNI_CLASS_IOCTL_CALL_EXCEPTION);
-        jmethodID constructor = (*env) -> GetMethodID(env, exception_clazz, JNI_METHOD_CONSTRUCTOR, JNI_SIGNATURE_METHOD_INT_INT_INT_VOID);
-        jobject exception = (*env) -> NewObject(env, exception_clazz, constructor,
-            (jint) rcIoctl, (jint) errno, (jint) __errno2());
-        (*env) -> Throw(env, exception);
-        return;
+        throw_ioctl_call_exception(env, rcIoctl, errnoValue, errno2Value);
     }
 }
 
+/**
+ * Issues the command together with query (and certificate if requested). Cached values are cleaned before, because
+ * the command changes state of the connection, and they are filled from the same response.
+ */
+void issueCommandAndQuery(JNIEnv *env, jobject obj, int command, int operation, jboolean certificate)
+{
+    clean_context(env, obj, JNI_TRUE);
+    struct TTLS_IOCTL* ioc = load_command(env, obj, command, operation, certificate);
+    releaseIoctl(env, obj, ioc);
+}
+
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_initConnectionAndQueryNative(JNIEnv *env, jobject obj, jboolean certificate)
+{
+    issueCommandAndQuery(env, obj, TTLS_INIT_CONNECTION, METRICS_INIT_CONNECTION, certificate);
+}
+
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_resetSessionAndQueryNative(JNIEnv *env, jobject obj, jboolean certificate)
+{
+    issueCommandAndQuery(env, obj, TTLS_RESET_SESSION, METRICS_RESET_SESSION, certificate);
+}
+
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_resetCipherAndQueryNative(JNIEnv *env, jobject obj, jboolean certificate)
+{
+    issueCommandAndQuery(env, obj, TTLS_RESET_CIPHER, METRICS_RESET_CIPHER, certificate);
+}
+
 JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_initConnection(JNIEnv *env, jobject obj)
 {
-    issueCommand(env, obj, TTLS_INIT_CONNECTION);
+    issueCommand(env, obj, TTLS_INIT_CONNECTION, METRICS_INIT_CONNECTION);
 }
 
 JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_resetSession(JNIEnv *env, jobject obj)
 {
-    issueCommand(env, obj, TTLS_RESET_SESSION);
+    issueCommand(env, obj, TTLS_RESET_SESSION, METRICS_RESET_SESSION);
 }
 
 JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_resetCipher(JNIEnv *env, jobject obj)
 {
-    issueCommand(env, obj, TTLS_RESET_CIPHER);
+    issueCommand(env, obj, TTLS_RESET_CIPHER, METRICS_RESET_CIPHER);
 }
 
 JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_stopConnection(JNIEnv *env, jobject obj)
 {
-    issueCommand(env, obj, TTLS_STOP_CONNECTION);
+    issueCommand(env, obj, TTLS_STOP_CONNECTION, METRICS_STOP_CONNECTION);
 }
 
 JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_allowHandShakeTimeout(JNIEnv *env, jobject obj)
 {
-    issueCommand(env, obj, TTLS_ALLOW_HSTIMEOUT);
+    issueCommand(env, obj, TTLS_ALLOW_HSTIMEOUT, METRICS_ALLOW_HSTIMEOUT);
+}
+
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_readNativeMetrics(JNIEnv *env, jclass clazz, jlongArray target)
+{
+    int length = metrics_length(&metrics);
+    if (!target || ((*env) -> GetArrayLength(env, target) < length)) return length;
+
+    jlong* values = (jlong*) malloc(length * sizeof(jlong));
+    if (!values) return length;
+    metrics_copy(&metrics, (long long*) values);
+    (*env) -> SetLongArrayRegion(env, target, 0, length, values);
+    free(values);
+    return length;
+}
+
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_readConnectionStatistics(JNIEnv *env, jclass clazz, jlongArray target)
+{
+    int length = stats_length();
+    if (!target || ((*env) -> GetArrayLength(env, target) < length)) return length;
+
+    jlong* values = (jlong*) malloc(length * sizeof(jlong));
+    if (!values) return length;
+    stats_copy(&connection_stats, (long long*) values);
+    (*env) -> SetLongArrayRegion(env, target, 0, length, values);
+    free(values);
+    return length;
 }
 
 
@@ -845,16 +1767,18 @@ JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_allowHandShakeTi
 void free_enum_map(JNIEnv* env, EnumMap** ref)
 {
     EnumMap* enum_map = *ref;
-    for (int i = 0; i < enum_map -> max_value; i++)
+    int count = enum_map -> size1 * enum_map -> size2;
+    for (int i = 0; i < count; i++)
     {
         if (!enum_map -> values[i]) continue;
         (*env) -> DeleteGlobalRef(env, enum_map -> values[i]);
     }
+    (*env) -> DeleteGlobalRef(env, enum_map -> unrecognized);
     (*env) -> DeleteGlobalRef(env, enum_map -> clazz);
     free(enum_map -> values);
     free(enum_map);
 
-    ref = NULL;
+    *ref = NULL;
 }
 
 /**
@@ -866,11 +1790,24 @@ void JNI_OnUnload(JavaVM *vm, void *reserved)
 
     // delete global referencies
     (*env) -> DeleteGlobalRef(env, attls_context_clazz);
-    (*env) -> DeleteGlobalRef(env, enum_protocol_clazz);
+    (*env) -> DeleteGlobalRef(env, byte_buffer_clazz);
+    (*env) -> DeleteGlobalRef(env, illegal_argument_exception_clazz);
+    (*env) -> DeleteGlobalRef(env, unknown_enum_value_exception_clazz);
+    (*env) -> DeleteGlobalRef(env, ioctl_call_exception_clazz);
+    (*env) -> DeleteGlobalRef(env, certificate_response_clazz);
 
     // free EnumMap structs
-    free_enum_map(env, stat_policy_enum_map);
-    free_enum_map(env, stat_conn_enum_map);
-    free_enum_map(env, security_type_enum_map);
-    free_enum_map(env, fips140_enum_map);
+    free_enum_map(env, &stat_policy_enum_map);
+    free_enum_map(env, &stat_conn_enum_map);
+    free_enum_map(env, &security_type_enum_map);
+    free_enum_map(env, &fips140_enum_map);
+    free_enum_map(env, &protocol_enum_map);
+
+    // free tables of ciphers
+    free_cipher_table(env, &cipher2_table);
+    free_cipher_table(env, &cipher4_table);
+
+    // release interned user IDs
+    user_id_intern_free(env);
+    certificate_info_free(env);
 }
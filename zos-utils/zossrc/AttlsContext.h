@@ -20,12 +20,20 @@ extern "C" {
 
 /*
  * Class:     org_zowe_commons_attls_AttlsContext
- * Method:    clean
+ * Method:    cleanNative
  * Signature: ()V
  */
-JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_clean
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_cleanNative
   (JNIEnv *, jobject);
 
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    resetNative
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_resetNative
+  (JNIEnv *, jobject, jint);
+
 /*
  * Class:     org_zowe_commons_attls_AttlsContext
  * Method:    getStatPolicy
@@ -147,6 +155,118 @@ JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_stopConnection
 JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_allowHandShakeTimeout
   (JNIEnv *, jobject);
 
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    getPackedStatus
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_org_zowe_commons_attls_AttlsContext_getPackedStatus
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    readNativeMetrics
+ * Signature: ([J)I
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_readNativeMetrics
+  (JNIEnv *, jclass, jlongArray);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    tryQuery
+ * Signature: ([J)I
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_tryQuery
+  (JNIEnv *, jobject, jlongArray);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    getCipherSuite
+ * Signature: ()Lorg/zowe/commons/attls/CipherSuite;
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getCipherSuite
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    getCertificateInfo
+ * Signature: ()Lorg/zowe/commons/x509/CertificateInfo;
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_getCertificateInfo
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    mapCertificateToUserId
+ * Signature: ()Lorg/zowe/commons/usermap/CertificateResponse;
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_attls_AttlsContext_mapCertificateToUserId
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    getNegotiatedKeyShare
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_org_zowe_commons_attls_AttlsContext_getNegotiatedKeyShare
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    getQueryVersion
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_getQueryVersion
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    copyCertificate
+ * Signature: ([BII)I
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_copyCertificate
+  (JNIEnv *, jobject, jbyteArray, jint, jint);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    copyCertificateDirect
+ * Signature: (Ljava/nio/ByteBuffer;II)I
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_copyCertificateDirect
+  (JNIEnv *, jobject, jobject, jint, jint);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    readConnectionStatistics
+ * Signature: ([J)I
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_attls_AttlsContext_readConnectionStatistics
+  (JNIEnv *, jclass, jlongArray);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    initConnectionAndQueryNative
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_initConnectionAndQueryNative
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    resetSessionAndQueryNative
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_resetSessionAndQueryNative
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     org_zowe_commons_attls_AttlsContext
+ * Method:    resetCipherAndQueryNative
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_zowe_commons_attls_AttlsContext_resetCipherAndQueryNative
+  (JNIEnv *, jobject, jboolean);
+
 
 
 #ifdef __cplusplus
@@ -0,0 +1,46 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Backend of AT-TLS library. It hides calls of z/OS services, so the JNI layer (AttlsContext.c) can be built with
+ * different implementations:
+ *  - attlsBackendZos.c - calls ioctl SIOCTTLSCTL and __certificate on z/OS
+ *  - linux/attlsBackendSim.c - simulator with scripted answers for build hosts without z/OS
+ */
+
+#ifndef _Included_attls_backend
+#define _Included_attls_backend
+
+#include <resolv.h>
+#include <ezbztlsc.h>
+
+/**
+ * Initialization of backend, it is called on loading of library. Returns 0 on success.
+ */
+int attls_backend_init(void);
+
+/**
+ * Calls ioctl SIOCTTLSCTL with the request on the socket. It returns the same values as ioctl (and sets errno).
+ */
+int attls_backend_ioctl(int socket, struct TTLS_IOCTL* ioc);
+
+/**
+ * Maps partner certificate to user ID (see __certificate with __CERTIFICATE_AUTHENTICATE). The user ID is in EBCDIC.
+ * It returns the same values as __certificate (and sets errno).
+ */
+int attls_backend_map_certificate(int certificateLength, char* certificate, int useridLength, char* userid);
+
+/**
+ * Returns reason code (errno2) of the last failed call.
+ */
+int attls_backend_errno2(void);
+
+#endif
@@ -0,0 +1,37 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+#define _OPEN_SYS
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <errno.h>
+
+#include "attlsBackend.h"
+
+int attls_backend_init(void)
+{
+    return 0;
+}
+
+int attls_backend_ioctl(int socket, struct TTLS_IOCTL* ioc)
+{
+    return ioctl(socket, SIOCTTLSCTL, (char*) ioc);
+}
+
+int attls_backend_map_certificate(int certificateLength, char* certificate, int useridLength, char* userid)
+{
+    return __certificate(__CERTIFICATE_AUTHENTICATE, certificateLength, certificate, useridLength, userid);
+}
+
+int attls_backend_errno2(void)
+{
+    return __errno2();
+}
@@ -0,0 +1,371 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+#include <string.h>
+
+#include "certificateInfo.h"
+
+#pragma convert(819)
+const char *JNI_CLASS_CERTIFICATE_INFO = "org/zowe/commons/x509/CertificateInfo";
+const char *JNI_CLASS_CERTIFICATE_INFO_EXCEPTION = "java/lang/IllegalArgumentException";
+const char *JNI_METHOD_CERTIFICATE_INFO_CONSTRUCTOR = "<init>";
+const char *JNI_SIGNATURE_CERTIFICATE_INFO_CONSTRUCTOR = "([B[B[BJJ[B)V";
+const char *JNI_MESSAGE_INVALID_CERTIFICATE = "Certificate is not valid DER encoded X.509 certificate";
+#pragma convert(0)
+
+/**
+ * DER tags used in certificate
+ */
+#define DER_INTEGER           0x02
+#define DER_UTC_TIME          0x17
+#define DER_GENERALIZED_TIME  0x18
+#define DER_SEQUENCE          0x30
+#define DER_VERSION           0xA0
+
+/**
+ * Characters of time in DER are always ASCII (the source could be compiled in EBCDIC)
+ */
+#define ASCII_0 0x30
+#define ASCII_9 0x39
+#define ASCII_Z 0x5A
+
+static jclass certificate_info_clazz;
+static jmethodID certificate_info_constructor;
+static jclass certificate_info_exception_clazz;
+
+/**
+ * Reads one element (tag and length) at position. On success it moves the position after the header, sets the content
+ * and returns its tag, otherwise it returns -1.
+ */
+static int der_read(const unsigned char** position, const unsigned char* end, DerSlice* content)
+{
+    const unsigned char* p = *position;
+    if (end - p < 2) return -1;
+
+    int tag = *p++;
+    // multi-byte tags are not used in certificate
+    if ((tag & 0x1F) == 0x1F) return -1;
+
+    int length = *p++;
+    if (length & 0x80) {
+        int bytes = length & 0x7F;
+        if ((bytes == 0) || (bytes > 3) || (end - p < bytes)) return -1;
+        length = 0;
+        while (bytes--) length = (length << 8) | *p++;
+    }
+    if (end - p < length) return -1;
+
+    content -> data = p;
+    content -> length = length;
+    *position = p;
+    return tag;
+}
+
+/**
+ * Reads element with the expected tag, the position is moved after whole element. If whole is not NULL, it is set to
+ * the element including its header.
+ */
+static int der_expect(const unsigned char** position, const unsigned char* end, int tag, DerSlice* content, DerSlice* whole)
+{
+    const unsigned char* start = *position;
+    if (der_read(position, end, content) != tag) return -1;
+    *position = content -> data + content -> length;
+    if (whole) {
+        whole -> data = start;
+        whole -> length = (int) (*position - start);
+    }
+    return 0;
+}
+
+/**
+ * Reads decimal number of count digits (ASCII)
+ */
+static int read_digits(const unsigned char* p, int count)
+{
+    int value = 0;
+    for (int i = 0; i < count; i++) {
+        if ((p[i] < ASCII_0) || (p[i] > ASCII_9)) return -1;
+        value = value * 10 + (p[i] - ASCII_0);
+    }
+    return value;
+}
+
+/**
+ * Returns number of days since 1970-01-01 (proleptic Gregorian calendar)
+ */
+static long long days_from_civil(int year, int month, int day)
+{
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return (long long) era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * Converts UTCTime (YYMMDDHHMMSSZ) or GeneralizedTime (YYYYMMDDHHMMSSZ) into milliseconds since epoch
+ */
+static int der_time(int tag, DerSlice* time, long long* out)
+{
+    const unsigned char* p = time -> data;
+    int year;
+    if (tag == DER_UTC_TIME) {
+        if ((time -> length != 13) || (p[12] != ASCII_Z)) return -1;
+        year = read_digits(p, 2);
+        if (year < 0) return -1;
+        // RFC 5280: 50-99 means 19xx, 00-49 means 20xx
+        year += year < 50 ? 2000 : 1900;
+        p += 2;
+    } else if (tag == DER_GENERALIZED_TIME) {
+        if ((time -> length != 15) || (p[14] != ASCII_Z)) return -1;
+        year = read_digits(p, 4);
+        if (year < 0) return -1;
+        p += 4;
+    } else {
+        return -1;
+    }
+
+    int month = read_digits(p, 2);
+    int day = read_digits(p + 2, 2);
+    int hour = read_digits(p + 4, 2);
+    int minute = read_digits(p + 6, 2);
+    int second = read_digits(p + 8, 2);
+    if ((month < 1) || (month > 12) || (day < 1) || (day > 31)) return -1;
+    if ((hour < 0) || (hour > 23) || (minute < 0) || (minute > 59) || (second < 0) || (second > 60)) return -1;
+
+    long long seconds = days_from_civil(year, month, day) * 86400LL + hour * 3600 + minute * 60 + second;
+    *out = seconds * 1000;
+    return 0;
+}
+
+int certificate_parse(const unsigned char* der, int length, CertificateFields* fields)
+{
+    if (!der || (length <= 0) || !fields) return -1;
+
+    const unsigned char* p = der;
+    const unsigned char* end = der + length;
+    DerSlice certificate, tbs, skip, validity, time;
+
+    // Certificate ::= SEQUENCE { tbsCertificate, signatureAlgorithm, signatureValue }
+    if (der_read(&p, end, &certificate) != DER_SEQUENCE) return -1;
+    p = certificate.data;
+    end = certificate.data + certificate.length;
+    if (der_read(&p, end, &tbs) != DER_SEQUENCE) return -1;
+    p = tbs.data;
+    end = tbs.data + tbs.length;
+
+    // version is optional (default v1)
+    if ((p < end) && (*p == DER_VERSION)) {
+        if (der_expect(&p, end, DER_VERSION, &skip, NULL)) return -1;
+    }
+    if (der_expect(&p, end, DER_INTEGER, &fields -> serialNumber, NULL)) return -1;
+    if (der_expect(&p, end, DER_SEQUENCE, &skip, NULL)) return -1;
+    if (der_expect(&p, end, DER_SEQUENCE, &skip, &fields -> issuer)) return -1;
+
+    // Validity ::= SEQUENCE { notBefore Time, notAfter Time }
+    if (der_expect(&p, end, DER_SEQUENCE, &validity, NULL)) return -1;
+    const unsigned char* v = validity.data;
+    const unsigned char* validityEnd = validity.data + validity.length;
+    int tag = der_read(&v, validityEnd, &time);
+    if (der_time(tag, &time, &fields -> notBefore)) return -1;
+    v = time.data + time.length;
+    tag = der_read(&v, validityEnd, &time);
+    if (der_time(tag, &time, &fields -> notAfter)) return -1;
+
+    if (der_expect(&p, end, DER_SEQUENCE, &skip, &fields -> subject)) return -1;
+    return 0;
+}
+
+/**
+ * Portable implementation of SHA-256 (FIPS 180-4). It does not depend on endianness of platform.
+ */
+static const unsigned int SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_block(unsigned int state[8], const unsigned char* block)
+{
+    unsigned int w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((unsigned int) block[i * 4] << 24) | ((unsigned int) block[i * 4 + 1] << 16)
+            | ((unsigned int) block[i * 4 + 2] << 8) | block[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        unsigned int s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        unsigned int s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    unsigned int a = state[0], b = state[1], c = state[2], d = state[3];
+    unsigned int e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+        unsigned int t1 = h + (ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+        unsigned int t2 = (ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+#ifdef __MVS__
+
+/**
+ * CPACF computes SHA-256 by KIMD (function 2) if the processor provides it. Availability is checked once by the query
+ * function in certificate_info_init, the portable implementation is used otherwise. The parameter block of KIMD is the
+ * chaining value (8 big-endian words), the same as state of the portable implementation.
+ */
+#define KIMD_QUERY  0
+#define KIMD_SHA256 2
+
+#ifdef _LP64
+#define KIMD_LOAD " LGR "
+#else
+#define KIMD_LOAD " LR "
+#endif
+
+static int kimd_sha256_available = 0;
+
+/**
+ * Calls KIMD with the function code, the parameter block and the second operand (length is a multiple of 64). KIMD
+ * could end after a part of data (condition code 3), then it is repeated.
+ */
+static void kimd(long function, void* parameters, const unsigned char* data, long length)
+{
+    __asm(
+        KIMD_LOAD "0,%0\n"
+        KIMD_LOAD "1,%1\n"
+        KIMD_LOAD "2,%2\n"
+        KIMD_LOAD "3,%3\n"
+        " KIMD 0,2\n"
+        " BRC 1,*-4\n"
+        :
+        : "r"(function), "r"(parameters), "r"(data), "r"(length)
+        : "r0", "r1", "r2", "r3", "memory"
+    );
+}
+
+static void sha256_query(void)
+{
+    // bit n of the status is set if function code n is available
+    unsigned char status[16] = {0};
+    kimd(KIMD_QUERY, status, NULL, 0);
+    kimd_sha256_available = (status[KIMD_SHA256 / 8] & (0x80 >> (KIMD_SHA256 % 8))) != 0;
+}
+
+#endif
+
+/**
+ * Processes whole blocks of data (length is a multiple of 64)
+ */
+static void sha256_blocks(unsigned int state[8], const unsigned char* data, int length)
+{
+#ifdef __MVS__
+    if (kimd_sha256_available) {
+        if (length) kimd(KIMD_SHA256, state, data, length);
+        return;
+    }
+#endif
+    for (int offset = 0; offset < length; offset += 64) sha256_block(state, data + offset);
+}
+
+void certificate_sha256(const unsigned char* data, int length, unsigned char digest[SHA256_DIGEST_LENGTH])
+{
+    unsigned int state[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    int offset = length - length % 64;
+    sha256_blocks(state, data, offset);
+
+    // padding: 0x80, zeros and length in bits (big endian)
+    unsigned char tail[128] = {0};
+    int rest = length - offset;
+    memcpy(tail, data + offset, rest);
+    tail[rest] = 0x80;
+    int tailLength = rest < 56 ? 64 : 128;
+    unsigned long long bits = (unsigned long long) length * 8;
+    for (int i = 0; i < 8; i++) tail[tailLength - 1 - i] = (unsigned char) (bits >> (8 * i));
+    sha256_blocks(state, tail, tailLength);
+
+    for (int i = 0; i < 8; i++) {
+        digest[i * 4] = (unsigned char) (state[i] >> 24);
+        digest[i * 4 + 1] = (unsigned char) (state[i] >> 16);
+        digest[i * 4 + 2] = (unsigned char) (state[i] >> 8);
+        digest[i * 4 + 3] = (unsigned char) state[i];
+    }
+}
+
+int certificate_info_init(JNIEnv *env)
+{
+#ifdef __MVS__
+    sha256_query();
+#endif
+
+    jclass clazz = (*env) -> FindClass(env, JNI_CLASS_CERTIFICATE_INFO);
+    if (!clazz) return -1;
+    certificate_info_clazz = (*env) -> NewGlobalRef(env, clazz);
+    certificate_info_constructor = (*env) -> GetMethodID(env, clazz, JNI_METHOD_CERTIFICATE_INFO_CONSTRUCTOR, JNI_SIGNATURE_CERTIFICATE_INFO_CONSTRUCTOR);
+    if (!certificate_info_constructor) return -1;
+
+    clazz = (*env) -> FindClass(env, JNI_CLASS_CERTIFICATE_INFO_EXCEPTION);
+    if (!clazz) return -1;
+    certificate_info_exception_clazz = (*env) -> NewGlobalRef(env, clazz);
+    return 0;
+}
+
+/**
+ * Creates Java byte array with content of slice
+ */
+static jbyteArray to_array(JNIEnv *env, const unsigned char* data, int length)
+{
+    jbyteArray array = (*env) -> NewByteArray(env, length);
+    if (array) (*env) -> SetByteArrayRegion(env, array, 0, length, (const jbyte*) data);
+    return array;
+}
+
+jobject certificate_info_create(JNIEnv *env, const unsigned char* der, int length)
+{
+    CertificateFields fields;
+    if (certificate_parse(der, length, &fields)) {
+        (*env) -> ThrowNew(env, certificate_info_exception_clazz, JNI_MESSAGE_INVALID_CERTIFICATE);
+        return NULL;
+    }
+
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    certificate_sha256(der, length, digest);
+
+    jbyteArray serialNumber = to_array(env, fields.serialNumber.data, fields.serialNumber.length);
+    jbyteArray issuer = to_array(env, fields.issuer.data, fields.issuer.length);
+    jbyteArray subject = to_array(env, fields.subject.data, fields.subject.length);
+    jbyteArray fingerprint = to_array(env, digest, SHA256_DIGEST_LENGTH);
+    if (!serialNumber || !issuer || !subject || !fingerprint) return NULL;
+
+    return (*env) -> NewObject(env, certificate_info_clazz, certificate_info_constructor,
+        serialNumber, issuer, subject, (jlong) fields.notBefore, (jlong) fields.notAfter, fingerprint);
+}
+
+void certificate_info_free(JNIEnv *env)
+{
+    if (certificate_info_clazz) (*env) -> DeleteGlobalRef(env, certificate_info_clazz);
+    if (certificate_info_exception_clazz) (*env) -> DeleteGlobalRef(env, certificate_info_exception_clazz);
+    certificate_info_clazz = NULL;
+    certificate_info_exception_clazz = NULL;
+}
@@ -0,0 +1,69 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+/**
+ * Extraction of basic fields of X.509 certificate (serial number, issuer, subject and validity) and its SHA-256
+ * fingerprint. It walks the DER encoding only to the subject, no other part of the certificate is parsed and nothing is
+ * allocated. It is used by both native libraries to create org.zowe.commons.x509.CertificateInfo.
+ */
+
+#ifndef _Included_certificate_info
+#define _Included_certificate_info
+
+#include <jni.h>
+
+#define SHA256_DIGEST_LENGTH 32
+
+/**
+ * Part of DER encoding (content of the element or whole element for names)
+ */
+typedef struct DerSlice {
+    const unsigned char* data;
+    int length;
+} DerSlice;
+
+/**
+ * Fields of certificate, slices point into the source. Times are in milliseconds since epoch.
+ */
+typedef struct CertificateFields {
+    DerSlice serialNumber;
+    DerSlice issuer;
+    DerSlice subject;
+    long long notBefore;
+    long long notAfter;
+} CertificateFields;
+
+/**
+ * Reads fields of DER encoded certificate. Returns 0 on success, -1 if the encoding is not valid.
+ */
+int certificate_parse(const unsigned char* der, int length, CertificateFields* fields);
+
+/**
+ * Computes SHA-256 digest of data. On z/OS CPACF is used if the processor provides it (see certificate_info_init).
+ */
+void certificate_sha256(const unsigned char* data, int length, unsigned char digest[SHA256_DIGEST_LENGTH]);
+
+/**
+ * Resolves Java classes and checks CPACF functions, it is called on loading of library. Returns 0 on success.
+ */
+int certificate_info_init(JNIEnv *env);
+
+/**
+ * Creates CertificateInfo of DER encoded certificate. If the certificate is not valid, IllegalArgumentException is
+ * thrown and NULL is returned.
+ */
+jobject certificate_info_create(JNIEnv *env, const unsigned char* der, int length);
+
+/**
+ * Deletes global references, it is called on unloading of library.
+ */
+void certificate_info_free(JNIEnv *env);
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+#include <errno.h>
+#include <stddef.h>
+
+#include "connectionStats.h"
+
+static int byte_slot(unsigned char value)
+{
+    return value < STATS_BYTE_SLOTS - 1 ? value : STATS_BYTE_SLOTS - 1;
+}
+
+static int protocol_slot(unsigned char version, unsigned char mod)
+{
+    if ((version >= STATS_PROTOCOL_VERSIONS) || (mod >= STATS_PROTOCOL_MODS)) return STATS_PROTOCOL_SLOTS - 1;
+    return version * STATS_PROTOCOL_MODS + mod;
+}
+
+/**
+ * Layout of stats_key: slots of policy status, connection status, FIPS 140 and protocol (8 bits each), cipher code + 1
+ * (17 bits), stripe (8 bits) and a flag of counted connection, so the key is never 0
+ */
+#define KEY_CIPHER_SHIFT 32
+#define KEY_STRIPE_SHIFT 49
+#define KEY_COUNTED (1LL << 60)
+#define KEY_SLOT(key, index) ((int) (((key) >> (8 * (index))) & 0xFF))
+
+/**
+ * Adds delta to all counters of the key
+ */
+static void stats_update(ConnectionStats* stats, stats_key key, metrics_counter delta)
+{
+    ConnectionStatsStripe* stripe = stats->stripes + (int) ((key >> KEY_STRIPE_SHIFT) & 0xFF);
+    int cipherKey = (int) ((key >> KEY_CIPHER_SHIFT) & 0x1FFFF);
+
+    metrics_add(&stripe->connections, delta);
+    metrics_add(stripe->statPolicy + KEY_SLOT(key, 0), delta);
+    metrics_add(stripe->statConn + KEY_SLOT(key, 1), delta);
+    metrics_add(stripe->fips140 + KEY_SLOT(key, 2), delta);
+    metrics_add(stripe->protocol + KEY_SLOT(key, 3), delta);
+
+    if (!cipherKey) return;
+    int counted = (delta == 1) ?
+        metrics_count_code(stripe->ciphers, STATS_CIPHER_SLOTS, cipherKey) :
+        metrics_uncount_code(stripe->ciphers, STATS_CIPHER_SLOTS, cipherKey);
+    if (!counted) metrics_add(&stripe->ciphersOverflow, delta);
+}
+
+stats_key stats_add(ConnectionStats* stats, int socket, unsigned char statPolicy, unsigned char statConn,
+    unsigned char protocolVersion, unsigned char protocolMod, unsigned char fips140, int cipher)
+{
+    int savedErrno = errno;
+
+    // code is stored increased by one, zero marks an empty slot (and no cipher)
+    stats_key key = KEY_COUNTED
+        | ((stats_key) ((unsigned int) socket % STATS_STRIPES) << KEY_STRIPE_SHIFT)
+        | ((stats_key) (cipher == STATS_NO_CIPHER ? 0 : (cipher & 0xFFFF) + 1) << KEY_CIPHER_SHIFT)
+        | ((stats_key) protocol_slot(protocolVersion, protocolMod) << 24)
+        | ((stats_key) byte_slot(fips140) << 16)
+        | ((stats_key) byte_slot(statConn) << 8)
+        | (stats_key) byte_slot(statPolicy);
+    stats_update(stats, key, 1);
+
+    errno = savedErrno;
+    return key;
+}
+
+void stats_remove(ConnectionStats* stats, stats_key key)
+{
+    if (!key) return;
+
+    int savedErrno = errno;
+    stats_update(stats, key, (metrics_counter) -1);
+    errno = savedErrno;
+}
+
+int stats_length(void)
+{
+    return STATS_HEADER_LENGTH + 3 * STATS_BYTE_SLOTS + STATS_PROTOCOL_SLOTS + 2 * STATS_CIPHER_SLOTS;
+}
+
+static long long* sum_counters(ConnectionStats* stats, int offset, int count, long long* target)
+{
+    for (int i = 0; i < count; i++) {
+        long long sum = 0;
+        for (int s = 0; s < STATS_STRIPES; s++) {
+            sum += (long long) ((volatile metrics_counter*) (((char*) (stats->stripes + s)) + offset))[i];
+        }
+        *target++ = sum;
+    }
+    return target;
+}
+
+/**
+ * Merges cipher slots of all stripes into target (pairs of key and count). Returns count of ciphers which did not fit.
+ */
+static long long merge_ciphers(ConnectionStats* stats, long long* target)
+{
+    long long overflow = 0;
+    for (int s = 0; s < STATS_STRIPES; s++) {
+        MetricsCode* slots = stats->stripes[s].ciphers;
+        for (int i = 0; i < STATS_CIPHER_SLOTS; i++) {
+            long long key = (long long) slots[i].key;
+            long long count = (long long) slots[i].count;
+            if (!key) continue;
+
+            int j = 0;
+            while ((j < STATS_CIPHER_SLOTS) && target[2 * j] && (target[2 * j] != key)) j++;
+            if (j == STATS_CIPHER_SLOTS) {
+                overflow += count;
+                continue;
+            }
+            target[2 * j] = key;
+            target[2 * j + 1] += count;
+        }
+    }
+    return overflow;
+}
+
+void stats_copy(ConnectionStats* stats, long long* target)
+{
+    long long* header = target;
+    *target++ = STATS_VERSION;
+    *target++ = STATS_BYTE_SLOTS;
+    *target++ = STATS_PROTOCOL_SLOTS;
+    *target++ = STATS_CIPHER_SLOTS;
+    target = sum_counters(stats, offsetof(ConnectionStatsStripe, connections), 1, target);
+    target = sum_counters(stats, offsetof(ConnectionStatsStripe, ciphersOverflow), 1, target);
+
+    target = sum_counters(stats, offsetof(ConnectionStatsStripe, statPolicy), STATS_BYTE_SLOTS, target);
+    target = sum_counters(stats, offsetof(ConnectionStatsStripe, statConn), STATS_BYTE_SLOTS, target);
+    target = sum_counters(stats, offsetof(ConnectionStatsStripe, fips140), STATS_BYTE_SLOTS, target);
+    target = sum_counters(stats, offsetof(ConnectionStatsStripe, protocol), STATS_PROTOCOL_SLOTS, target);
+
+    for (int i = 0; i < 2 * STATS_CIPHER_SLOTS; i++) target[i] = 0;
+    header[5] += merge_ciphers(stats, target);
+}
@@ -0,0 +1,93 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Gauges of the population of queried connections: how many connections have each policy status, connection status,
+ * protocol, FIPS 140 level and cipher. A connection is added by its first successful query ioctl, replaced if it is
+ * queried again (ie. after a command) and removed when its context is cleaned or reset. The key returned by stats_add
+ * is kept by the context to remove exactly the counted values, no Java object is created.
+ *
+ * Counters are striped by file descriptor of the socket, so concurrent queries of different connections update
+ * different memory. Each update is an atomic addition (no locks). Reader sums all stripes without any synchronization,
+ * so a snapshot could be slightly inconsistent, but it never blocks queries.
+ *
+ * Single-byte values (ie. policy status) are counted by value, values from STATS_BYTE_SLOTS - 1 (and negative) share
+ * the last slot. Protocol is counted by version and modifier, unknown versions share the last slot. Ciphers are
+ * counted by their numeric code in an open-addressed table.
+ */
+
+#ifndef _Included_connection_stats
+#define _Included_connection_stats
+
+#include "nativeMetrics.h"
+
+#define STATS_VERSION 2
+#define STATS_STRIPES 16
+#define STATS_BYTE_SLOTS 8
+#define STATS_PROTOCOL_VERSIONS 4
+#define STATS_PROTOCOL_MODS 8
+#define STATS_PROTOCOL_SLOTS (STATS_PROTOCOL_VERSIONS * STATS_PROTOCOL_MODS + 1)
+#define STATS_CIPHER_SLOTS 32
+
+/**
+ * Header of copied statistics: version, number of byte slots, number of protocol slots, number of cipher slots,
+ * count of connections and overflow of ciphers
+ */
+#define STATS_HEADER_LENGTH 6
+
+/**
+ * Cipher is not available (ie. connection is not secure)
+ */
+#define STATS_NO_CIPHER -1
+
+typedef struct ConnectionStatsStripe {
+    volatile metrics_counter connections;
+    volatile metrics_counter statPolicy[STATS_BYTE_SLOTS];
+    volatile metrics_counter statConn[STATS_BYTE_SLOTS];
+    volatile metrics_counter fips140[STATS_BYTE_SLOTS];
+    volatile metrics_counter protocol[STATS_PROTOCOL_SLOTS];
+    MetricsCode ciphers[STATS_CIPHER_SLOTS];
+    volatile metrics_counter ciphersOverflow;
+} ConnectionStatsStripe;
+
+typedef struct ConnectionStats {
+    ConnectionStatsStripe stripes[STATS_STRIPES];
+} ConnectionStats;
+
+/**
+ * Key of counted connection, 0 means the connection is not counted
+ */
+typedef long long stats_key;
+
+/**
+ * Adds the connection identified by socket. Cipher is the numeric code of the cipher suite or STATS_NO_CIPHER. Returns
+ * the key to remove the connection by stats_remove. It does not modify errno.
+ */
+stats_key stats_add(ConnectionStats* stats, int socket, unsigned char statPolicy, unsigned char statConn,
+    unsigned char protocolVersion, unsigned char protocolMod, unsigned char fips140, int cipher);
+
+/**
+ * Removes the connection added by stats_add, key 0 is ignored. It does not modify errno.
+ */
+void stats_remove(ConnectionStats* stats, stats_key key);
+
+/**
+ * Returns number of values in the copy of statistics (see stats_copy).
+ */
+int stats_length(void);
+
+/**
+ * Copies sums of all stripes into target as header, counters of policy status, connection status, FIPS 140 and
+ * protocol, then cipher slots (code + 1 and count). The target must have at least stats_length values.
+ */
+void stats_copy(ConnectionStats* stats, long long* target);
+
+#endif
@@ -11,14 +11,37 @@
 #define _OPEN_SYS
 #include <unistd.h>
 #include <errno.h>
-#include "zowe-common-c/h/rusermap.h"
+#include "usermapBackend.h"
+#include "nativeMetrics.h"
+#include "userIdIntern.h"
+#include "certificateInfo.h"
+#include "transcode.h"
 #include "javaUsermap.h"
 #include <stdio.h>
+#include <stdlib.h>
 /**
  * Define version of JNI for this library
  */
 #define JNI_VERSION JNI_VERSION_1_8
 
+/**
+ * Operations measured by metrics (see NativeMetrics.USERMAP_OPERATIONS)
+ */
+#define METRICS_CERTIFICATE 0
+#define METRICS_DN          1
+#define METRICS_OPERATIONS  2
+
+/**
+ * Maximal lengths of distinguished name and registry name (see R_usermap)
+ */
+#define DN_MAX_LENGTH       246
+#define REGISTRY_MAX_LENGTH 255
+
+/**
+ * Counters and latency histograms of SAF calls
+ */
+Metrics metrics = { METRICS_OPERATIONS };
+
 #pragma convert(819)
 const char *JNI_CLASS_ILLEGAL_ARGUMENT_EXCEPTION = "java/lang/IllegalArgumentException";
 
@@ -31,7 +54,13 @@ const char *JNI_CLASS_CERTIFICATE_RESPONSE = "org/zowe/commons/usermap/Certifica
 
 const char *JNI_MESSAGE_CANNOT_CONVERT_USER_ID = "Cannot convert userID";
 const char *JNI_MESSAGE_DN_NAME_TOO_LONG = "Distinguished name is not allowed to be more than 246 characters";
+const char *JNI_MESSAGE_CERTIFICATE_IS_NULL = "Certificate cannot be null";
+const char *JNI_MESSAGE_CERTIFICATES_ARE_NULL = "Certificates cannot be null";
+const char *JNI_MESSAGE_DNS_ARE_NULL = "Distinguished names cannot be null";
 const char *JNI_MESSAGE_REGISTRY_NAME_TOO_LONG = "Registry name is not allowed to be more than 255 characters";
+const char *JNI_MESSAGE_CANNOT_CONVERT_TO_EBCDIC = "Value contains a character which cannot be converted into EBCDIC";
+const char *JNI_MESSAGE_DIRECT_BUFFER_REQUIRED = "Direct buffer is required";
+const char *JNI_MESSAGE_OUT_OF_BUFFER = "Offset and length are out of the buffer";
 #pragma convert(0)
 
 jclass certificateClass;
@@ -40,14 +69,6 @@ jclass mapperClass;
 jmethodID mapperClassCtor;
 jclass exception_clazz;
 
-int strnlen(char *txt, int max) {
-    if (max < 0) return 0;
-    for (int i = 0; i < max; i++) {
-        if (!txt[i]) return i;
-    }
-    return max;
-}
-
 /**
  * Return Java environment by virtual machine. It is useful for load and unload event.
  */
@@ -63,6 +84,10 @@ JNIEnv* getEnv(JavaVM *vm) {
      JNIEnv* env = getEnv(vm);
      if (env == NULL) return JNI_ERR;
 
+     if (usermap_backend_init()) return JNI_ERR;
+     if (user_id_intern_init()) return JNI_ERR;
+     if (certificate_info_init(env)) return JNI_ERR;
+
      certificateClass = (*env) -> NewGlobalRef(env, (*env) -> FindClass(env, JNI_CLASS_CERTIFICATE_RESPONSE));
      if (certificateClass == NULL) return JNI_ERR;
 
@@ -80,85 +105,270 @@ JNIEnv* getEnv(JavaVM *vm) {
 
      return JNI_VERSION;
  }
+
 /**
- * It reads String from memory in EBCDIC with length up to value in argument length
+ * Clean memory on unloading
  */
-jstring get_jstring(JNIEnv *env, char* ebcdic, int length)
-{
-    if (!ebcdic || (length < 0)) return NULL;
-
-    int realSize = strnlen(ebcdic, length);
-    if (realSize < length) {
-        length = realSize;
-    }
-    char *output = (char*) __malloc31(length + 1);
-    strncpy(output, ebcdic, length);
-    output[length] = 0;
-
-    int size = __etoa(output);
-    if (size < 0) {
+void JNI_OnUnload(JavaVM *vm, void *reserved) {
+    JNIEnv* env = getEnv(vm);
+    if (env == NULL) return;
+
+    (*env) -> DeleteGlobalRef(env, certificateClass);
+    (*env) -> DeleteGlobalRef(env, mapperClass);
+    (*env) -> DeleteGlobalRef(env, exception_clazz);
+    user_id_intern_free(env);
+    certificate_info_free(env);
+}
+/**
+ * Returns Java string of RACF user ID (EBCDIC, 8 characters and terminating zero). Repeated IDs are interned.
+ */
+jstring get_user_id(JNIEnv *env, char* useridRacf) {
+    jstring out = user_id_intern(env, useridRacf, 8);
+    if (!out) out = transcode_new_string(env, useridRacf, 8);
+    if (!out && !(*env) -> ExceptionCheck(env)) {
         (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_CANNOT_CONVERT_USER_ID);
-        free(output);
-        return NULL;
     }
+    return out;
+}
+
+/**
+ * Result of certificate mapping before it is converted into CertificateResponse
+ */
+typedef struct CertificateResult {
+    char useridRacf[9];
+    int rc;
+    int errnoValue;
+    int errno2Value;
+} CertificateResult;
 
-    jstring outputJstring = (*env) -> NewStringUTF(env, output);
-    free(output);
-    return outputJstring;
+/**
+ * Maps certificate in memory to user ID
+ */
+void map_certificate_memory(char* certificate, int certificateLength, CertificateResult* result) {
+    memset(result -> useridRacf, 0, sizeof(result -> useridRacf));
+
+    metrics_counter start = metrics_now();
+    result -> rc = usermap_backend_certificate(certificateLength, certificate, sizeof(result -> useridRacf), result -> useridRacf);
+    result -> errnoValue = errno;
+    result -> errno2Value = usermap_backend_errno2();
+    metrics_record(&metrics, METRICS_CERTIFICATE, start, result -> rc != 0, result -> errnoValue, result -> errno2Value);
 }
 
-JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_getUserIDForCertificate(JNIEnv *env, jobject obj, jbyteArray certificate) {
+/**
+ * Creates CertificateResponse from the result of mapping
+ */
+jobject create_certificate_response(JNIEnv *env, CertificateResult* result) {
+    jstring jUseridRacf = get_user_id(env, result -> useridRacf);
+    return (*env)->NewObject(env, certificateClass, certificateClassCtor, jUseridRacf,
+        result -> rc, result -> errnoValue, result -> errno2Value);
+}
 
+/**
+ * Maps one certificate to user ID and returns CertificateResponse. It returns NULL if the certificate is null
+ * (IllegalArgumentException is thrown) or it cannot be pinned (OutOfMemoryError is thrown).
+ */
+jobject map_certificate(JNIEnv *env, jbyteArray certificate) {
+    if (!certificate) {
+        (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_CERTIFICATE_IS_NULL);
+        return NULL;
+    }
+
+    CertificateResult result;
     jbyte* cCertificate = (*env) -> GetByteArrayElements(env, certificate, NULL);
+    if (!cCertificate) return NULL;
     int certificateLength = (*env) -> GetArrayLength(env, certificate);
+    map_certificate_memory((char*) cCertificate, certificateLength, &result);
+    (*env)->ReleaseByteArrayElements(env, certificate, cCertificate, JNI_ABORT);
+
+    return create_certificate_response(env, &result);
+}
+
+/**
+ * Returns address of the region in direct buffer or NULL (IllegalArgumentException is thrown) if the buffer is not
+ * direct or the region is out of the buffer
+ */
+char* get_direct_region(JNIEnv *env, jobject buffer, jint offset, jint length) {
+    char* address = buffer ? (char*) (*env) -> GetDirectBufferAddress(env, buffer) : NULL;
+    if (!address) {
+        (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_DIRECT_BUFFER_REQUIRED);
+        return NULL;
+    }
+    jlong capacity = (*env) -> GetDirectBufferCapacity(env, buffer);
+    if ((offset < 0) || (length < 0) || ((jlong) offset + length > capacity)) {
+        (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_OUT_OF_BUFFER);
+        return NULL;
+    }
+    return address + offset;
+}
+
+/**
+ * Copies Java string into the buffer and converts it into EBCDIC. It returns length of string or -1 if the string is
+ * longer than the maximal length (IllegalArgumentException with the message is thrown) or it cannot be converted.
+ */
+int get_ebcdic(JNIEnv *env, jstring value, char* buffer, int maxLength, const char* message) {
+    int length = transcode_get_ebcdic(env, value, buffer, maxLength);
+    if (length == TRANSCODE_ERROR_LENGTH) {
+        (*env) -> ThrowNew(env, exception_clazz, message);
+        return -1;
+    }
+    if (length < 0) {
+        (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_CANNOT_CONVERT_TO_EBCDIC);
+        return -1;
+    }
+    return length;
+}
+
+/**
+ * Maps distinguished name in registry (both in EBCDIC) to user ID and returns MapperResponse
+ */
+jobject map_dn_memory(JNIEnv *env, char* distinguishedName, int dnLength, char* registryEbcidic, int registryLength) {
     char useridRacf[9] = {0};
-    int userId_length = 9;
     int returnCodeRacf = 0;
     int reasonCodeRacf = 0;
 
-    int rc = __certificate(__CERTIFICATE_AUTHENTICATE, certificateLength, (char*) cCertificate, userId_length, useridRacf);
-    (*env)->ReleaseByteArrayElements(env, certificate, cCertificate, 0);
+    metrics_counter start = metrics_now();
+    int rc = usermap_backend_dn(distinguishedName, dnLength, registryEbcidic, registryLength, useridRacf, &returnCodeRacf, &reasonCodeRacf);
+    metrics_record(&metrics, METRICS_DN, start, rc != 0, returnCodeRacf, reasonCodeRacf);
+
+    jstring jUseridRacf = get_user_id(env, useridRacf);
+
+    return (*env)->NewObject(env, mapperClass, mapperClassCtor, jUseridRacf, rc, rc, returnCodeRacf, reasonCodeRacf);
+}
 
-    e2a(useridRacf, 9);
+/**
+ * Maps one distinguished name in registry (already converted into EBCDIC) to user ID and returns MapperResponse
+ */
+jobject map_dn(JNIEnv *env, jstring dn, char* registryEbcidic, int registryLength) {
+    char distinguishedName[DN_MAX_LENGTH] = {0};
+    int dnLength = get_ebcdic(env, dn, distinguishedName, sizeof(distinguishedName), JNI_MESSAGE_DN_NAME_TOO_LONG);
+    if (dnLength < 0) return NULL;
+
+    return map_dn_memory(env, distinguishedName, dnLength, registryEbcidic, registryLength);
+}
+
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_mapCertificate(JNIEnv *env, jobject obj, jbyteArray certificate) {
+    return map_certificate(env, certificate);
+}
 
-    jstring jUseridRacf = (*env)->NewStringUTF(env, useridRacf);
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_mapDN(JNIEnv *env, jobject obj, jstring dn, jstring reg){
+    char registryEbcidic[REGISTRY_MAX_LENGTH] = {0};
+    int registryLength = get_ebcdic(env, reg, registryEbcidic, sizeof(registryEbcidic), JNI_MESSAGE_REGISTRY_NAME_TOO_LONG);
+    if (registryLength < 0) return NULL;
 
-    return (*env)->NewObject(env, certificateClass, certificateClassCtor, jUseridRacf, rc, errno, __errno2());
+    return map_dn(env, dn, registryEbcidic, registryLength);
 }
 
-JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_getUserIDForDN(JNIEnv *env, jobject obj, jstring dn, jstring reg){
-    const char* distName = (*env) -> GetStringUTFChars(env, dn, NULL);
-    int dnLength = (*env) -> GetStringUTFLength(env, dn);
-    if(dnLength > 246) {
+/**
+ * Maps certificate (DER) in direct buffer, SAF reads the buffer in place
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_mapCertificateDirect(JNIEnv *env, jobject obj, jobject certificate, jint offset, jint length) {
+    char* cCertificate = get_direct_region(env, certificate, offset, length);
+    if (!cCertificate) return NULL;
+
+    CertificateResult result;
+    map_certificate_memory(cCertificate, length, &result);
+    return create_certificate_response(env, &result);
+}
+
+/**
+ * Maps distinguished name in registry, both are in direct buffers already in EBCDIC
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_mapDNDirect(JNIEnv *env, jobject obj,
+    jobject dn, jint dnOffset, jint dnLength, jobject reg, jint regOffset, jint regLength)
+{
+    char* distinguishedName = get_direct_region(env, dn, dnOffset, dnLength);
+    if (!distinguishedName) return NULL;
+    if (dnLength > DN_MAX_LENGTH) {
         (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_DN_NAME_TOO_LONG);
         return NULL;
     }
-    char distinguishedName[246] = {0};
-    memcpy(distinguishedName, distName, dnLength);
-    (*env) -> ReleaseStringUTFChars(env, dn, distName);
-    a2e(&distinguishedName, dnLength);
-
-    const char* registry = (*env)->GetStringUTFChars(env, reg, NULL);
-    int registryLength = (*env)->GetStringUTFLength(env, reg);
-    if(registryLength > 255) {
+
+    char* registryEbcidic = get_direct_region(env, reg, regOffset, regLength);
+    if (!registryEbcidic) return NULL;
+    if (regLength > REGISTRY_MAX_LENGTH) {
         (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_REGISTRY_NAME_TOO_LONG);
         return NULL;
     }
-    char registryEbcidic[255] = {0};
-    memcpy(registryEbcidic, registry, registryLength);
-    (*env) -> ReleaseStringUTFChars(env, reg, registry);
-    a2e(&registryEbcidic, registryLength);
-    char useridRacf[9] = {0};
-    int returnCodeRacf = 0;
-    int reasonCodeRacf = 0;
 
-    int rc = getUseridByDN(distinguishedName, dnLength, registryEbcidic, registryLength, useridRacf, &returnCodeRacf, &reasonCodeRacf);
+    return map_dn_memory(env, distinguishedName, dnLength, registryEbcidic, regLength);
+}
 
-    e2a(useridRacf, 9);
+/**
+ * Maps all certificates in one call. Local references of each item are released immediately, so the count of
+ * certificates is not limited by the capacity of local references.
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_zowe_commons_usermap_UserMapper_mapCertificates(JNIEnv *env, jobject obj, jobjectArray certificates) {
+    if (!certificates) {
+        (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_CERTIFICATES_ARE_NULL);
+        return NULL;
+    }
+
+    int count = (*env) -> GetArrayLength(env, certificates);
+    jobjectArray out = (*env) -> NewObjectArray(env, count, certificateClass, NULL);
+    if (!out) return NULL;
 
-    jstring jUseridRacf = (*env) -> NewStringUTF(env, useridRacf);
+    for (int i = 0; i < count; i++) {
+        jbyteArray certificate = (*env) -> GetObjectArrayElement(env, certificates, i);
+        jobject response = map_certificate(env, certificate);
+        (*env) -> DeleteLocalRef(env, certificate);
+        if (!response) return NULL;
 
-    return (*env)->NewObject(env, mapperClass, mapperClassCtor, jUseridRacf, rc, returnCodeRacf, returnCodeRacf, reasonCodeRacf);
+        (*env) -> SetObjectArrayElement(env, out, i, response);
+        (*env) -> DeleteLocalRef(env, response);
+    }
+    return out;
 }
 
+/**
+ * Maps all distinguished names in the registry in one call. The registry is converted just once.
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_zowe_commons_usermap_UserMapper_mapDNs(JNIEnv *env, jobject obj, jobjectArray dns, jstring reg) {
+    char registryEbcidic[REGISTRY_MAX_LENGTH] = {0};
+    int registryLength = get_ebcdic(env, reg, registryEbcidic, sizeof(registryEbcidic), JNI_MESSAGE_REGISTRY_NAME_TOO_LONG);
+    if (registryLength < 0) return NULL;
+    if (!dns) {
+        (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_DNS_ARE_NULL);
+        return NULL;
+    }
+
+    int count = (*env) -> GetArrayLength(env, dns);
+    jobjectArray out = (*env) -> NewObjectArray(env, count, mapperClass, NULL);
+    if (!out) return NULL;
+
+    for (int i = 0; i < count; i++) {
+        jstring dn = (*env) -> GetObjectArrayElement(env, dns, i);
+        jobject response = map_dn(env, dn, registryEbcidic, registryLength);
+        (*env) -> DeleteLocalRef(env, dn);
+        if (!response) return NULL;
 
+        (*env) -> SetObjectArrayElement(env, out, i, response);
+        (*env) -> DeleteLocalRef(env, response);
+    }
+    return out;
+}
+
+JNIEXPORT jint JNICALL Java_org_zowe_commons_usermap_UserMapper_readNativeMetrics(JNIEnv *env, jclass clazz, jlongArray target) {
+    int length = metrics_length(&metrics);
+    if (!target || ((*env) -> GetArrayLength(env, target) < length)) return length;
+
+    jlong* values = (jlong*) malloc(length * sizeof(jlong));
+    if (!values) return length;
+    metrics_copy(&metrics, (long long*) values);
+    (*env) -> SetLongArrayRegion(env, target, 0, length, values);
+    free(values);
+    return length;
+}
+
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_getCertificateInfo(JNIEnv *env, jobject obj, jbyteArray certificate) {
+    if (!certificate) {
+        (*env) -> ThrowNew(env, exception_clazz, JNI_MESSAGE_CERTIFICATE_IS_NULL);
+        return NULL;
+    }
+
+    jbyte* cCertificate = (*env) -> GetByteArrayElements(env, certificate, NULL);
+    if (!cCertificate) return NULL;
+    int certificateLength = (*env) -> GetArrayLength(env, certificate);
+    jobject out = certificate_info_create(env, (const unsigned char*) cCertificate, certificateLength);
+    (*env) -> ReleaseByteArrayElements(env, certificate, cCertificate, JNI_ABORT);
+    return out;
+}
@@ -19,20 +19,70 @@ extern "C" {
 #endif
 /*
  * Class:     org_zowe_commons_usermap_UserMapper
- * Method:    getUserIDForCertificate
+ * Method:    mapCertificate
  * Signature: ([B)Lorg/zowe/commons/usermap/CertificateResponse;
  */
-JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_getUserIDForCertificate
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_mapCertificate
   (JNIEnv *, jobject, jbyteArray);
 
 /*
  * Class:     org_zowe_commons_usermap_UserMapper
- * Method:    getUserIDForDN
+ * Method:    mapDN
  * Signature: (Ljava/lang/String;Ljava/lang/String;)Lorg/zowe/commons/usermap/MapperResponse;
  */
-JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_getUserIDForDN
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_mapDN
   (JNIEnv *, jobject, jstring, jstring);
 
+/*
+ * Class:     org_zowe_commons_usermap_UserMapper
+ * Method:    mapCertificates
+ * Signature: ([[B)[Lorg/zowe/commons/usermap/CertificateResponse;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_zowe_commons_usermap_UserMapper_mapCertificates
+  (JNIEnv *, jobject, jobjectArray);
+
+/*
+ * Class:     org_zowe_commons_usermap_UserMapper
+ * Method:    mapDNs
+ * Signature: ([Ljava/lang/String;Ljava/lang/String;)[Lorg/zowe/commons/usermap/MapperResponse;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_zowe_commons_usermap_UserMapper_mapDNs
+  (JNIEnv *, jobject, jobjectArray, jstring);
+
+/*
+ * Class:     org_zowe_commons_usermap_UserMapper
+ * Method:    readNativeMetrics
+ * Signature: ([J)I
+ */
+JNIEXPORT jint JNICALL Java_org_zowe_commons_usermap_UserMapper_readNativeMetrics
+  (JNIEnv *, jclass, jlongArray);
+
+/*
+ * Class:     org_zowe_commons_usermap_UserMapper
+ * Method:    getCertificateInfo
+ * Signature: ([B)Lorg/zowe/commons/x509/CertificateInfo;
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_getCertificateInfo
+  (JNIEnv *, jobject, jbyteArray);
+
+/*
+ * Class:     org_zowe_commons_usermap_UserMapper
+ * Method:    mapCertificateDirect
+ * Signature: (Ljava/nio/ByteBuffer;II)Lorg/zowe/commons/usermap/CertificateResponse;
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_mapCertificateDirect
+  (JNIEnv *, jobject, jobject, jint, jint);
+
+/*
+ * Class:     org_zowe_commons_usermap_UserMapper
+ * Method:    mapDNDirect
+ * Signature: (Ljava/nio/ByteBuffer;IILjava/nio/ByteBuffer;II)Lorg/zowe/commons/usermap/MapperResponse;
+ */
+JNIEXPORT jobject JNICALL Java_org_zowe_commons_usermap_UserMapper_mapDNDirect
+  (JNIEnv *, jobject, jobject, jint, jint, jobject, jint, jint);
+
+
+
 #ifdef __cplusplus
 }
 #endif
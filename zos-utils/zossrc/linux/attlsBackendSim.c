@@ -0,0 +1,228 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Simulator of AT-TLS ioctl. Each socket with a non-negative descriptor is a connection with the configured state.
+ *
+ * Keys (prefix attls.):
+ *  - statPolicy, statConn, securityType, fips140, flags - values of the same fields in TTLS_IOCTL
+ *  - protocol - version and modification, ie. "3.3" for TLSv1.2
+ *  - cipher, cipher4 - negotiated cipher (2 and 4 characters)
+ *  - keyShare - negotiated key share group (4 characters), it is returned only to TTLS_VERSION2 request
+ *  - queryVersion - the highest supported version of request (1 or 2), newer requests fail with EINVAL
+ *  - userId - user ID mapped by AT-TLS, empty means no mapping
+ *  - certificate - path to DER file with the partner certificate
+ *  - certificateLength - generates a dummy certificate of this length (if certificate is not set)
+ *  - latencyMicros - duration of each call
+ *  - failEvery, errno, errno2 - each failEvery-th call fails with errno and errno2
+ *  - mappedUserId - user ID of the certificate mapped by SAF (__certificate)
+ *  - mapRc, mapErrno, mapErrno2 - result of the certificate mapping (rc -1 means failure with errno and errno2)
+ */
+
+#include <jni.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "attlsBackend.h"
+#include "simulator.h"
+
+typedef struct AttlsSimulator {
+    unsigned char statPolicy;
+    unsigned char statConn;
+    unsigned char protocolVersion;
+    unsigned char protocolModification;
+    unsigned char securityType;
+    unsigned char fips140;
+    unsigned char flags;
+    char cipher[2];
+    char cipher4[4];
+    char keyShare[4];
+    int queryVersion;
+    char userId[8];
+    int userIdLength;
+    char* certificate;
+    int certificateLength;
+    int latencyMicros;
+    int failEvery;
+    int errnoValue;
+    int errno2Value;
+    char mappedUserId[8];
+    int mappedUserIdLength;
+    int mapRc;
+    int mapErrnoValue;
+    int mapErrno2Value;
+    unsigned long calls;
+} AttlsSimulator;
+
+static AttlsSimulator simulator;
+
+static void set_certificate(char* certificate, int length)
+{
+    char* previous = simulator.certificate;
+    simulator.certificate = certificate;
+    simulator.certificateLength = length;
+    free(previous);
+}
+
+static void load_certificate(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open certificate of native simulator: %s\n", path);
+        return;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* certificate = malloc(length > 0 ? length : 1);
+    if (certificate && (fread(certificate, 1, length, file) == (size_t) length)) {
+        set_certificate(certificate, length);
+    } else {
+        free(certificate);
+    }
+    fclose(file);
+}
+
+static void generate_certificate(int length)
+{
+    if (length <= 0) {
+        set_certificate(NULL, 0);
+        return;
+    }
+
+    char* certificate = malloc(length);
+    if (!certificate) return;
+    for (int i = 0; i < length; i++) {
+        certificate[i] = (char) (i & 0xFF);
+    }
+    set_certificate(certificate, length);
+}
+
+static void configure(const char* key, const char* value)
+{
+    if (strcmp(key, "statPolicy") == 0) simulator.statPolicy = sim_parse_number(value);
+    else if (strcmp(key, "statConn") == 0) simulator.statConn = sim_parse_number(value);
+    else if (strcmp(key, "securityType") == 0) simulator.securityType = sim_parse_number(value);
+    else if (strcmp(key, "fips140") == 0) simulator.fips140 = sim_parse_number(value);
+    else if (strcmp(key, "flags") == 0) simulator.flags = sim_parse_number(value);
+    else if (strcmp(key, "protocol") == 0) {
+        unsigned int version = 0, modification = 0;
+        sscanf(value, "%u.%u", &version, &modification);
+        simulator.protocolVersion = version;
+        simulator.protocolModification = modification;
+    }
+    else if (strcmp(key, "cipher") == 0) sim_set_ebcdic(simulator.cipher, 2, value, 0);
+    else if (strcmp(key, "cipher4") == 0) sim_set_ebcdic(simulator.cipher4, 4, value, 0);
+    else if (strcmp(key, "keyShare") == 0) sim_set_ebcdic(simulator.keyShare, 4, value, 0);
+    else if (strcmp(key, "queryVersion") == 0) simulator.queryVersion = sim_parse_number(value);
+    else if (strcmp(key, "userId") == 0) simulator.userIdLength = sim_set_ebcdic(simulator.userId, 8, value, 0);
+    else if (strcmp(key, "certificate") == 0) load_certificate(value);
+    else if (strcmp(key, "certificateLength") == 0) generate_certificate(sim_parse_number(value));
+    else if (strcmp(key, "latencyMicros") == 0) simulator.latencyMicros = sim_parse_number(value);
+    else if (strcmp(key, "failEvery") == 0) simulator.failEvery = sim_parse_number(value);
+    else if (strcmp(key, "errno") == 0) simulator.errnoValue = sim_parse_number(value);
+    else if (strcmp(key, "errno2") == 0) simulator.errno2Value = sim_parse_number(value);
+    else if (strcmp(key, "mappedUserId") == 0) simulator.mappedUserIdLength = sim_set_ebcdic(simulator.mappedUserId, 8, value, 0);
+    else if (strcmp(key, "mapRc") == 0) simulator.mapRc = sim_parse_number(value);
+    else if (strcmp(key, "mapErrno") == 0) simulator.mapErrnoValue = sim_parse_number(value);
+    else if (strcmp(key, "mapErrno2") == 0) simulator.mapErrno2Value = sim_parse_number(value);
+    else fprintf(stderr, "Unknown option of AT-TLS simulator: %s\n", key);
+}
+
+int attls_backend_init(void)
+{
+    memset(&simulator, 0, sizeof(simulator));
+    configure("statPolicy", "4");
+    configure("statConn", "3");
+    configure("protocol", "3.3");
+    configure("cipher", "35");
+    configure("cipher4", "0035");
+    configure("queryVersion", "2");
+    configure("securityType", "2");
+    configure("errno", "5");
+    configure("certificateLength", "1024");
+    configure("mappedUserId", "ZWESVUSR");
+    return sim_load_config("attls.", configure);
+}
+
+static int fail(int errnoValue, int errno2Value)
+{
+    errno = errnoValue;
+    sim_set_errno2(errno2Value);
+    return -1;
+}
+
+int attls_backend_ioctl(int socket, struct TTLS_IOCTL* ioc)
+{
+    sim_delay(simulator.latencyMicros);
+
+    if (socket < 0) return fail(EBADF, 0);
+    if ((ioc->TTLSi_Ver < TTLS_VERSION1) || (ioc->TTLSi_Ver > simulator.queryVersion)) return fail(EINVAL, 0);
+    if (sim_should_fail(simulator.failEvery, &simulator.calls)) {
+        return fail(simulator.errnoValue, simulator.errno2Value);
+    }
+
+    if (ioc->TTLSi_Req_Type & TTLS_QUERY_ONLY) {
+        ioc->TTLSi_Stat_Policy = simulator.statPolicy;
+        ioc->TTLSi_Stat_Conn = simulator.statConn;
+        ioc->TTLSi_SSL_Protocol.Prot_bytes.Prot_Ver = simulator.protocolVersion;
+        ioc->TTLSi_SSL_Protocol.Prot_bytes.Prot_Mod = simulator.protocolModification;
+        memcpy(ioc->TTLSi_Neg_Cipher, simulator.cipher, 2);
+        memcpy(ioc->TTLSi_Neg_Cipher4, simulator.cipher4, 4);
+        if (ioc->TTLSi_Ver >= TTLS_VERSION2) memcpy(ioc->TTLSi_Neg_KeyShare, simulator.keyShare, 4);
+        ioc->TTLSi_Sec_Type = simulator.securityType;
+        memcpy(ioc->TTLSi_UserID, simulator.userId, 8);
+        ioc->TTLSi_UserID_Len = simulator.userIdLength;
+        ioc->TTLSi_FIPS140 = simulator.fips140;
+        ioc->TTLSi_Flags = simulator.flags;
+    }
+
+    if (ioc->TTLSi_Req_Type & TTLS_RETURN_CERTIFICATE) {
+        ioc->TTLSi_Cert_Len = simulator.certificateLength;
+        if (simulator.certificateLength > (int) ioc->TTLSi_BufferLen) return fail(ENOBUFS, 0);
+        if (simulator.certificateLength) memcpy(ioc->TTLSi_BufferPtr, simulator.certificate, simulator.certificateLength);
+    }
+
+    return 0;
+}
+
+int attls_backend_map_certificate(int certificateLength, char* certificate, int useridLength, char* userid)
+{
+    sim_delay(simulator.latencyMicros);
+
+    if (simulator.mapRc) {
+        fail(simulator.mapErrnoValue, simulator.mapErrno2Value);
+        return simulator.mapRc;
+    }
+
+    memset(userid, 0, useridLength);
+    memcpy(userid, simulator.mappedUserId, useridLength < simulator.mappedUserIdLength ? useridLength : simulator.mappedUserIdLength);
+    return 0;
+}
+
+int attls_backend_errno2(void)
+{
+    return sim_get_errno2();
+}
+
+JNIEXPORT void JNICALL Java_org_zowe_commons_zos_NativeSimulator_configureAttls
+  (JNIEnv* env, jclass clazz, jstring key, jstring value)
+{
+    const char* keyChars = (*env)->GetStringUTFChars(env, key, NULL);
+    const char* valueChars = (*env)->GetStringUTFChars(env, value, NULL);
+    configure(keyChars, valueChars);
+    (*env)->ReleaseStringUTFChars(env, value, valueChars);
+    (*env)->ReleaseStringUTFChars(env, key, keyChars);
+}
@@ -0,0 +1,60 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Replica of the z/OS header EZBZTLSC.H (AT-TLS ioctl interface) for the Linux build with simulator. It contains only
+ * the members used by AttlsContext.c, the names and values match the z/OS header.
+ */
+
+#ifndef _Included_ezbztlsc
+#define _Included_ezbztlsc
+
+#define SIOCTTLSCTL 0xC038D90B
+
+#define TTLS_VERSION1 1
+#define TTLS_VERSION2 2
+
+#define TTLS_QUERY_ONLY         0x01
+#define TTLS_INIT_CONNECTION    0x02
+#define TTLS_RESET_SESSION      0x04
+#define TTLS_RESET_CIPHER       0x08
+#define TTLS_STOP_CONNECTION    0x10
+#define TTLS_ALLOW_HSTIMEOUT    0x20
+#define TTLS_RETURN_CERTIFICATE 0x40
+
+struct TTLS_IOCTL {
+    unsigned short TTLSi_Ver;
+    unsigned char  TTLSi_Req_Type;
+    unsigned char  TTLSi_Rsvd1;
+    unsigned char  TTLSi_Stat_Policy;
+    unsigned char  TTLSi_Stat_Conn;
+    union {
+        unsigned short Prot_short;
+        struct {
+            unsigned char Prot_Ver;
+            unsigned char Prot_Mod;
+        } Prot_bytes;
+    } TTLSi_SSL_Protocol;
+    char           TTLSi_Neg_Cipher[2];
+    unsigned char  TTLSi_Sec_Type;
+    unsigned char  TTLSi_Rsvd2;
+    char           TTLSi_UserID[8];
+    unsigned short TTLSi_UserID_Len;
+    unsigned char  TTLSi_FIPS140;
+    unsigned char  TTLSi_Flags;
+    char           TTLSi_Neg_Cipher4[4];
+    char           TTLSi_Neg_KeyShare[4];
+    char*          TTLSi_BufferPtr;
+    unsigned int   TTLSi_BufferLen;
+    unsigned int   TTLSi_Cert_Len;
+};
+
+#endif
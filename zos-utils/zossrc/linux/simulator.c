@@ -0,0 +1,111 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "simulator.h"
+#include "transcode.h"
+
+#define MAX_LINE_LENGTH 4096
+
+static __thread int last_errno2;
+
+static char* trim(char* text)
+{
+    while (isspace((unsigned char) *text)) text++;
+    char* end = text + strlen(text);
+    while ((end > text) && isspace((unsigned char) end[-1])) end--;
+    *end = 0;
+    return text;
+}
+
+int sim_load_config(const char* prefix, SimulatorOption option)
+{
+    const char* path = getenv(SIMULATOR_CONFIG_ENV);
+    if (!path || !*path) return 0;
+
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open configuration of native simulator: %s\n", path);
+        return -1;
+    }
+
+    char line[MAX_LINE_LENGTH];
+    size_t prefixLength = strlen(prefix);
+    while (fgets(line, sizeof(line), file)) {
+        char* key = trim(line);
+        if (!*key || (*key == '#')) continue;
+
+        char* separator = strchr(key, '=');
+        if (!separator) continue;
+        *separator = 0;
+        key = trim(key);
+        char* value = trim(separator + 1);
+
+        if (strncmp(key, prefix, prefixLength) == 0) {
+            option(key + prefixLength, value);
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+long sim_parse_number(const char* value)
+{
+    if (!value) return 0;
+    return strtol(value, NULL, 0);
+}
+
+int sim_set_ebcdic(char* field, int fieldLength, const char* value, char padding)
+{
+    int length = value ? strlen(value) : 0;
+    if (length > fieldLength) length = fieldLength;
+
+    // configuration is in ISO8859-1, its bytes are the first 256 code points of Unicode
+    jchar chars[TRANSCODE_MAX_LENGTH];
+    if (length > TRANSCODE_MAX_LENGTH) length = TRANSCODE_MAX_LENGTH;
+    for (int i = 0; i < length; i++) chars[i] = (unsigned char) value[i];
+
+    memset(field, padding, fieldLength);
+    transcode_utf16_to_ebcdic(chars, length, field);
+    return length;
+}
+
+void sim_delay(int micros)
+{
+    if (micros <= 0) return;
+
+    struct timespec delay;
+    delay.tv_sec = micros / 1000000;
+    delay.tv_nsec = (micros % 1000000) * 1000L;
+    nanosleep(&delay, NULL);
+}
+
+int sim_should_fail(int failEvery, unsigned long* counter)
+{
+    if (failEvery <= 0) return 0;
+    return (__atomic_add_fetch(counter, 1, __ATOMIC_RELAXED) % failEvery) == 0;
+}
+
+void sim_set_errno2(int value)
+{
+    last_errno2 = value;
+}
+
+int sim_get_errno2(void)
+{
+    return last_errno2;
+}
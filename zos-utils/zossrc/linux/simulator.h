@@ -0,0 +1,61 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Common part of native simulators. The simulator replaces z/OS services by scripted answers, so the JNI code could be
+ * run and measured on a build host. The answers are set by a configuration file (see env ZOWE_NATIVE_SIMULATOR) or
+ * at runtime from Java (see org.zowe.commons.zos.NativeSimulator).
+ *
+ * Format of configuration file is a list of lines "key=value", lines starting with '#' are comments. Each backend
+ * reads only the keys with its prefix (attls., usermap.).
+ */
+
+#ifndef _Included_simulator
+#define _Included_simulator
+
+#define SIMULATOR_CONFIG_ENV "ZOWE_NATIVE_SIMULATOR"
+
+typedef void (*SimulatorOption)(const char* key, const char* value);
+
+/**
+ * Reads the configuration file and calls option for each key with the prefix (the prefix is removed). It returns
+ * 0 on success or if the file is not set.
+ */
+int sim_load_config(const char* prefix, SimulatorOption option);
+
+/**
+ * Parses decimal or hexadecimal (0x) number, invalid value is 0.
+ */
+long sim_parse_number(const char* value);
+
+/**
+ * Copies value into the fixed-size field and converts it to EBCDIC, the rest of field is filled by padding.
+ * Returns length of the value in the field.
+ */
+int sim_set_ebcdic(char* field, int fieldLength, const char* value, char padding);
+
+/**
+ * Simulated latency of the service.
+ */
+void sim_delay(int micros);
+
+/**
+ * Returns 1 if this call should fail (each failEvery-th call on the counter), 0 otherwise.
+ */
+int sim_should_fail(int failEvery, unsigned long* counter);
+
+/**
+ * Reason code (errno2) of the last simulated failure of the current thread.
+ */
+void sim_set_errno2(int value);
+int sim_get_errno2(void);
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Simulator of user mapping services (__certificate and R_usermap). Every certificate and distinguished name is mapped
+ * to the same configured result.
+ *
+ * Keys (prefix usermap.):
+ *  - userId - mapped user ID
+ *  - rc, errno, errno2 - result of certificate mapping (rc -1 means failure with errno and errno2)
+ *  - safRc, racfRc, racfRs - result of distinguished name mapping
+ *  - latencyMicros - duration of each call
+ *  - failEvery - each failEvery-th call fails with the configured result, other calls succeed
+ */
+
+#include <jni.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "usermapBackend.h"
+#include "simulator.h"
+
+typedef struct UsermapSimulator {
+    char userId[8];
+    int userIdLength;
+    int rc;
+    int errnoValue;
+    int errno2Value;
+    int safRc;
+    int racfRc;
+    int racfRs;
+    int latencyMicros;
+    int failEvery;
+    unsigned long calls;
+} UsermapSimulator;
+
+static UsermapSimulator simulator;
+
+static void configure(const char* key, const char* value)
+{
+    if (strcmp(key, "userId") == 0) simulator.userIdLength = sim_set_ebcdic(simulator.userId, 8, value, 0);
+    else if (strcmp(key, "rc") == 0) simulator.rc = sim_parse_number(value);
+    else if (strcmp(key, "errno") == 0) simulator.errnoValue = sim_parse_number(value);
+    else if (strcmp(key, "errno2") == 0) simulator.errno2Value = sim_parse_number(value);
+    else if (strcmp(key, "safRc") == 0) simulator.safRc = sim_parse_number(value);
+    else if (strcmp(key, "racfRc") == 0) simulator.racfRc = sim_parse_number(value);
+    else if (strcmp(key, "racfRs") == 0) simulator.racfRs = sim_parse_number(value);
+    else if (strcmp(key, "latencyMicros") == 0) simulator.latencyMicros = sim_parse_number(value);
+    else if (strcmp(key, "failEvery") == 0) simulator.failEvery = sim_parse_number(value);
+    else fprintf(stderr, "Unknown option of user mapping simulator: %s\n", key);
+}
+
+int usermap_backend_init(void)
+{
+    memset(&simulator, 0, sizeof(simulator));
+    configure("userId", "ZWESVUSR");
+    return sim_load_config("usermap.", configure);
+}
+
+/**
+ * Returns 1 if the configured result should be returned, otherwise the call succeed.
+ */
+static int configured_result(void)
+{
+    sim_delay(simulator.latencyMicros);
+    if (simulator.failEvery <= 0) return 1;
+    return sim_should_fail(simulator.failEvery, &simulator.calls);
+}
+
+int usermap_backend_certificate(int certificateLength, char* certificate, int useridLength, char* userid)
+{
+    if (configured_result() && simulator.rc) {
+        errno = simulator.errnoValue;
+        sim_set_errno2(simulator.errno2Value);
+        return simulator.rc;
+    }
+
+    memset(userid, 0, useridLength);
+    memcpy(userid, simulator.userId, useridLength < simulator.userIdLength ? useridLength : simulator.userIdLength);
+    return 0;
+}
+
+int usermap_backend_dn(char* dn, int dnLength, char* registry, int registryLength, char* userid, int* returnCode,
+    int* reasonCode)
+{
+    if (configured_result() && simulator.safRc) {
+        *returnCode = simulator.racfRc;
+        *reasonCode = simulator.racfRs;
+        return simulator.safRc;
+    }
+
+    memset(userid, 0, 9);
+    memcpy(userid, simulator.userId, simulator.userIdLength);
+    *returnCode = 0;
+    *reasonCode = 0;
+    return 0;
+}
+
+int usermap_backend_errno2(void)
+{
+    return sim_get_errno2();
+}
+
+JNIEXPORT void JNICALL Java_org_zowe_commons_zos_NativeSimulator_configureUsermap
+  (JNIEnv* env, jclass clazz, jstring key, jstring value)
+{
+    const char* keyChars = (*env)->GetStringUTFChars(env, key, NULL);
+    const char* valueChars = (*env)->GetStringUTFChars(env, value, NULL);
+    configure(keyChars, valueChars);
+    (*env)->ReleaseStringUTFChars(env, value, valueChars);
+    (*env)->ReleaseStringUTFChars(env, key, keyChars);
+}
@@ -0,0 +1,28 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Replacement of z/OS runtime functions used by native libraries for the Linux build with simulator. This header is
+ * included into each source file by compiler option (see Makefile), the sources are the same as on z/OS.
+ */
+
+#ifndef _Included_zoscompat
+#define _Included_zoscompat
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * There is no 31-bit storage on Linux
+ */
+#define __malloc31(size) malloc(size)
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+#include <errno.h>
+#include <time.h>
+
+#ifdef __MVS__
+#include <builtins.h>
+#endif
+
+#include "nativeMetrics.h"
+
+#ifdef __MVS__
+
+/**
+ * TOD clock, bit 51 is one microsecond (4096 ticks), so one tick is 125/512 ns
+ */
+metrics_counter metrics_now(void)
+{
+    metrics_counter tod;
+    __stck(&tod);
+    return tod;
+}
+
+#define TICKS_TO_NANOS(ticks) (((ticks) * 125) >> 9)
+
+/**
+ * Compare and swap of 8 bytes (CSG in 64-bit, CDS in 31-bit mode). It returns 0 if value was swapped, otherwise
+ * expected is updated by the current value.
+ */
+static int compare_and_swap(volatile metrics_counter* target, metrics_counter* expected, metrics_counter value)
+{
+#ifdef _LP64
+    return __csg(expected, (void*) target, &value);
+#else
+    return __cds1(expected, (void*) target, &value);
+#endif
+}
+
+void metrics_add(volatile metrics_counter* target, metrics_counter value)
+{
+    metrics_counter expected = *target;
+    while (compare_and_swap(target, &expected, expected + value));
+}
+
+#else
+
+metrics_counter metrics_now(void)
+{
+    int errnoValue = errno;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    errno = errnoValue;
+    return ((metrics_counter) now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+#define TICKS_TO_NANOS(ticks) (ticks)
+
+static int compare_and_swap(volatile metrics_counter* target, metrics_counter* expected, metrics_counter value)
+{
+    return !__atomic_compare_exchange_n(target, expected, value, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+void metrics_add(volatile metrics_counter* target, metrics_counter value)
+{
+    __atomic_fetch_add(target, value, __ATOMIC_RELAXED);
+}
+
+#endif
+
+static void atomic_max(volatile metrics_counter* target, metrics_counter value)
+{
+    metrics_counter expected = *target;
+    while ((expected < value) && compare_and_swap(target, &expected, value));
+}
+
+static int highest_bit(metrics_counter value)
+{
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+}
+
+static int bucket_index(metrics_counter nanos)
+{
+    if (nanos < 4) return (int) nanos;
+
+    int bit = highest_bit(nanos);
+    int index = (bit - 1) * 4 + (int) ((nanos >> (bit - 2)) & 3);
+    return index < METRICS_BUCKETS ? index : METRICS_BUCKETS - 1;
+}
+
+int metrics_count_code(MetricsCode* slots, int slotCount, int code)
+{
+    if (!code) return 1;
+
+    metrics_counter key = (unsigned int) code;
+    int start = (int) (key % slotCount);
+    for (int i = 0; i < slotCount; i++) {
+        MetricsCode* slot = slots + ((start + i) % slotCount);
+        metrics_counter current = slot->key;
+        if (!current) {
+            // occupy the empty slot, if another thread was faster, check its key
+            metrics_counter empty = 0;
+            if (compare_and_swap(&slot->key, &empty, key)) {
+                current = empty;
+            } else {
+                current = key;
+            }
+        }
+        if (current == key) {
+            metrics_add(&slot->count, 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int metrics_uncount_code(MetricsCode* slots, int slotCount, int code)
+{
+    if (!code) return 1;
+
+    // slots are never released, so the probe ends on the first empty slot
+    metrics_counter key = (unsigned int) code;
+    int start = (int) (key % slotCount);
+    for (int i = 0; i < slotCount; i++) {
+        MetricsCode* slot = slots + ((start + i) % slotCount);
+        metrics_counter current = slot->key;
+        if (!current) return 0;
+        if (current == key) {
+            metrics_add(&slot->count, (metrics_counter) -1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Counts the code of failed call. If the table is full the code is counted as an overflow.
+ */
+static void count_code(Metrics* metrics, MetricsCode* slots, int code)
+{
+    if (!metrics_count_code(slots, METRICS_CODE_SLOTS, code)) metrics_add(&metrics->codesOverflow, 1);
+}
+
+void metrics_record(Metrics* metrics, int operation, metrics_counter startTicks, int failed, int errnoValue,
+    int errno2Value)
+{
+    if ((operation < 0) || (operation >= metrics->operationCount)) return;
+
+    int savedErrno = errno;
+    metrics_counter nanos = TICKS_TO_NANOS(metrics_now() - startTicks);
+
+    MetricsOperation* op = metrics->operations + operation;
+    metrics_add(&op->count, 1);
+    metrics_add(&op->totalNanos, nanos);
+    atomic_max(&op->maxNanos, nanos);
+    metrics_add(op->buckets + bucket_index(nanos), 1);
+
+    if (failed) {
+        metrics_add(&op->errors, 1);
+        count_code(metrics, metrics->errnos, errnoValue);
+        count_code(metrics, metrics->errno2s, errno2Value);
+    }
+
+    errno = savedErrno;
+}
+
+int metrics_length(Metrics* metrics)
+{
+    return METRICS_HEADER_LENGTH + metrics->operationCount * METRICS_OPERATION_LENGTH + 4 * METRICS_CODE_SLOTS;
+}
+
+static long long* copy_codes(MetricsCode* slots, long long* target)
+{
+    for (int i = 0; i < METRICS_CODE_SLOTS; i++) {
+        *target++ = (long long) slots[i].key;
+        *target++ = (long long) slots[i].count;
+    }
+    return target;
+}
+
+void metrics_copy(Metrics* metrics, long long* target)
+{
+    *target++ = METRICS_VERSION;
+    *target++ = metrics->operationCount;
+    *target++ = METRICS_BUCKETS;
+    *target++ = METRICS_CODE_SLOTS;
+    *target++ = (long long) metrics->codesOverflow;
+
+    for (int i = 0; i < metrics->operationCount; i++) {
+        MetricsOperation* op = metrics->operations + i;
+        *target++ = (long long) op->count;
+        *target++ = (long long) op->errors;
+        *target++ = (long long) op->totalNanos;
+        *target++ = (long long) op->maxNanos;
+        for (int j = 0; j < METRICS_BUCKETS; j++) {
+            *target++ = (long long) op->buckets[j];
+        }
+    }
+
+    target = copy_codes(metrics->errnos, target);
+    copy_codes(metrics->errno2s, target);
+}
@@ -0,0 +1,105 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Counters and latency histograms of native calls (ioctl, SAF). Each library has its own static instance. Recording
+ * uses only atomic additions (no locks), readers copy the values without any synchronization, so a snapshot could be
+ * slightly inconsistent (ie. count vs. sum of buckets), but it never blocks the measured calls.
+ *
+ * Histogram is log-linear: values 0-3 ns have own buckets, then each power of two is split into 4 linear buckets
+ * (relative error up to 25 %). The last bucket contains all longer calls.
+ */
+
+#ifndef _Included_native_metrics
+#define _Included_native_metrics
+
+#define METRICS_VERSION 1
+#define METRICS_MAX_OPERATIONS 8
+#define METRICS_BUCKETS 160
+#define METRICS_CODE_SLOTS 32
+
+/**
+ * Header of copied metrics: version, number of operations, number of buckets, number of code slots, overflow of codes
+ */
+#define METRICS_HEADER_LENGTH 5
+
+/**
+ * Values of one operation: count, errors, total nanoseconds, max nanoseconds and buckets
+ */
+#define METRICS_OPERATION_LENGTH (4 + METRICS_BUCKETS)
+
+typedef unsigned long long metrics_counter;
+
+typedef struct MetricsOperation {
+    volatile metrics_counter count;
+    volatile metrics_counter errors;
+    volatile metrics_counter totalNanos;
+    volatile metrics_counter maxNanos;
+    volatile metrics_counter buckets[METRICS_BUCKETS];
+} MetricsOperation;
+
+/**
+ * Counter of an error code (errno or errno2), empty slot has key 0
+ */
+typedef struct MetricsCode {
+    volatile metrics_counter key;
+    volatile metrics_counter count;
+} MetricsCode;
+
+typedef struct Metrics {
+    int operationCount;
+    MetricsOperation operations[METRICS_MAX_OPERATIONS];
+    MetricsCode errnos[METRICS_CODE_SLOTS];
+    MetricsCode errno2s[METRICS_CODE_SLOTS];
+    volatile metrics_counter codesOverflow;
+} Metrics;
+
+/**
+ * Returns the current time in ticks of the clock (TOD on z/OS, nanoseconds elsewhere). It does not modify errno.
+ */
+metrics_counter metrics_now(void);
+
+/**
+ * Records one call of the operation started at startTicks (see metrics_now). Codes of failed call are counted if they
+ * are not zero. It does not modify errno.
+ */
+void metrics_record(Metrics* metrics, int operation, metrics_counter startTicks, int failed, int errnoValue,
+    int errno2Value);
+
+/**
+ * Adds value to the counter atomically (without any lock).
+ */
+void metrics_add(volatile metrics_counter* target, metrics_counter value);
+
+/**
+ * Finds (or occupies) slot of the code in the open-addressed table and increments it. Code 0 is not counted. Returns
+ * 0 if the table is full and the code was not counted, otherwise 1.
+ */
+int metrics_count_code(MetricsCode* slots, int slotCount, int code);
+
+/**
+ * Decrements slot of the code counted by metrics_count_code. Returns 0 if the code has no slot (it was counted as an
+ * overflow), otherwise 1.
+ */
+int metrics_uncount_code(MetricsCode* slots, int slotCount, int code);
+
+/**
+ * Returns number of values in the copy of metrics (see metrics_copy).
+ */
+int metrics_length(Metrics* metrics);
+
+/**
+ * Copies metrics into target as header, operations, errno slots and errno2 slots (each slot is key and count). The
+ * target must have at least metrics_length values.
+ */
+void metrics_copy(Metrics* metrics, long long* target);
+
+#endif
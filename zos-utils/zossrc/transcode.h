@@ -0,0 +1,59 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Conversion of short strings between EBCDIC (IBM-1047) and Java strings (UTF-16). The code page is a bijection with
+ * the first 256 code points of Unicode, so both directions are lookups in 256-entry tables. Java strings are created
+ * by NewString from a buffer of chars on stack and read by GetStringRegion, so no memory is allocated and there is no
+ * intermediate conversion into modified UTF-8.
+ *
+ * Strings are limited by TRANSCODE_MAX_LENGTH (user IDs, codes of ciphers, distinguished names and registry names are
+ * shorter).
+ */
+
+#ifndef _Included_transcode
+#define _Included_transcode
+
+#include <jni.h>
+
+#define TRANSCODE_MAX_LENGTH 256
+
+/**
+ * Error codes of conversion
+ */
+#define TRANSCODE_ERROR_LENGTH  -1
+#define TRANSCODE_ERROR_INVALID -2
+
+/**
+ * Converts EBCDIC into UTF-16. The input ends at length or at the first zero byte. Returns count of converted chars.
+ */
+int transcode_ebcdic_to_utf16(const char* ebcdic, int length, jchar* out);
+
+/**
+ * Converts UTF-16 into EBCDIC. Returns length or TRANSCODE_ERROR_INVALID if a char is not in the code page (the
+ * content of out is not defined then).
+ */
+int transcode_utf16_to_ebcdic(const jchar* utf16, int length, char* out);
+
+/**
+ * Returns Java string (local reference) of EBCDIC, the string ends at length or at the first zero byte. It returns
+ * NULL if arguments are invalid (the string is longer than TRANSCODE_MAX_LENGTH) or the string cannot be created.
+ */
+jstring transcode_new_string(JNIEnv *env, const char* ebcdic, int length);
+
+/**
+ * Copies Java string into the buffer in EBCDIC (without terminating zero). Returns length of string,
+ * TRANSCODE_ERROR_LENGTH if the string is longer than maxLength (or TRANSCODE_MAX_LENGTH) or TRANSCODE_ERROR_INVALID
+ * if the string contains a char which is not in the code page.
+ */
+int transcode_get_ebcdic(JNIEnv *env, jstring value, char* buffer, int maxLength);
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+#ifdef __MVS__
+#define _OPEN_THREADS
+#endif
+#include <pthread.h>
+#include <string.h>
+
+#include "userIdIntern.h"
+#include "transcode.h"
+
+typedef struct InternEntry {
+    unsigned long long key;
+    jstring value;
+    int referenced;
+} InternEntry;
+
+typedef struct InternStripe {
+    pthread_mutex_t lock;
+    int count;
+    int hand;
+    InternEntry entries[USER_ID_INTERN_STRIPE_SIZE];
+} InternStripe;
+
+static InternStripe stripes[USER_ID_INTERN_STRIPES];
+
+int user_id_intern_init(void)
+{
+    for (int i = 0; i < USER_ID_INTERN_STRIPES; i++) {
+        memset(&stripes[i], 0, sizeof(InternStripe));
+        if (pthread_mutex_init(&stripes[i].lock, NULL)) return -1;
+    }
+    return 0;
+}
+
+static InternEntry* find(InternStripe* stripe, unsigned long long key)
+{
+    for (int i = 0; i < stripe -> count; i++) {
+        if (stripe -> entries[i].key == key) return stripe -> entries + i;
+    }
+    return NULL;
+}
+
+/**
+ * Returns free entry of stripe, if the stripe is full, the entry not referenced since the last pass is evicted
+ */
+static InternEntry* allocate(JNIEnv *env, InternStripe* stripe)
+{
+    if (stripe -> count < USER_ID_INTERN_STRIPE_SIZE) return stripe -> entries + stripe -> count++;
+
+    for (;;) {
+        InternEntry* entry = stripe -> entries + stripe -> hand;
+        stripe -> hand = (stripe -> hand + 1) % USER_ID_INTERN_STRIPE_SIZE;
+        if (entry -> referenced) {
+            entry -> referenced = 0;
+            continue;
+        }
+        (*env) -> DeleteGlobalRef(env, entry -> value);
+        return entry;
+    }
+}
+
+jstring user_id_intern(JNIEnv *env, const char* ebcdic, int length)
+{
+    if (!ebcdic || (length < 0)) return NULL;
+
+    // user ID ends with zero or by length
+    int realLength = 0;
+    while ((realLength < length) && ebcdic[realLength]) realLength++;
+    if (realLength > USER_ID_MAX_LENGTH) return NULL;
+
+    // key is the user ID padded by zeros, it is unique for each user ID (the ID cannot contain zero)
+    unsigned long long key = 0;
+    memcpy(&key, ebcdic, realLength);
+    InternStripe* stripe = stripes + (int) ((key * 0x9E3779B97F4A7C15ULL) >> 58) % USER_ID_INTERN_STRIPES;
+
+    jstring out = NULL;
+    pthread_mutex_lock(&stripe -> lock);
+    InternEntry* entry = find(stripe, key);
+    if (entry) {
+        entry -> referenced = 1;
+        out = (*env) -> NewLocalRef(env, entry -> value);
+    }
+    pthread_mutex_unlock(&stripe -> lock);
+    if (out) return out;
+
+    // convert outside of lock, another thread could add the same ID meanwhile
+    out = transcode_new_string(env, ebcdic, realLength);
+    if (!out) return NULL;
+
+    jobject global = (*env) -> NewGlobalRef(env, out);
+    if (!global) return out;
+
+    pthread_mutex_lock(&stripe -> lock);
+    entry = find(stripe, key);
+    if (entry) {
+        (*env) -> DeleteGlobalRef(env, global);
+        entry -> referenced = 1;
+    } else {
+        entry = allocate(env, stripe);
+        entry -> key = key;
+        entry -> value = global;
+        entry -> referenced = 0;
+    }
+    pthread_mutex_unlock(&stripe -> lock);
+    return out;
+}
+
+void user_id_intern_free(JNIEnv *env)
+{
+    for (int i = 0; i < USER_ID_INTERN_STRIPES; i++) {
+        InternStripe* stripe = stripes + i;
+        pthread_mutex_lock(&stripe -> lock);
+        for (int j = 0; j < stripe -> count; j++) {
+            (*env) -> DeleteGlobalRef(env, stripe -> entries[j].value);
+        }
+        stripe -> count = 0;
+        stripe -> hand = 0;
+        pthread_mutex_unlock(&stripe -> lock);
+    }
+}
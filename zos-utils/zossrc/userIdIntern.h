@@ -0,0 +1,48 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Intern table of user IDs. User IDs are short (up to 8 characters in EBCDIC) and their population is small, so the
+ * converted Java strings are kept as global references and repeated IDs are returned without any conversion or
+ * allocation.
+ *
+ * The table is split into stripes, each with its own lock and a fixed number of entries. If a stripe is full, an entry
+ * is evicted (CLOCK algorithm), so the count of global references is never bigger than USER_ID_INTERN_CAPACITY.
+ */
+
+#ifndef _Included_user_id_intern
+#define _Included_user_id_intern
+
+#include <jni.h>
+
+#define USER_ID_MAX_LENGTH 8
+#define USER_ID_INTERN_STRIPES 64
+#define USER_ID_INTERN_STRIPE_SIZE 64
+#define USER_ID_INTERN_CAPACITY (USER_ID_INTERN_STRIPES * USER_ID_INTERN_STRIPE_SIZE)
+
+/**
+ * Initialization of the table, it is called on loading of library. Returns 0 on success.
+ */
+int user_id_intern_init(void);
+
+/**
+ * Returns Java string (local reference) of user ID in EBCDIC. The user ID ends at length or at the first zero byte.
+ * It returns NULL if the user ID is longer than USER_ID_MAX_LENGTH or it cannot be converted. The caller should
+ * convert the value in the usual way then (and handle the error).
+ */
+jstring user_id_intern(JNIEnv *env, const char* ebcdic, int length);
+
+/**
+ * Delete all global references, it is called on unloading of library.
+ */
+void user_id_intern_free(JNIEnv *env);
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * This program and the accompanying materials are made available under the terms of the
+ * Eclipse Public License v2.0 which accompanies this distribution, and is available at
+ * https://www.eclipse.org/legal/epl-v20.html
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Copyright Contributors to the Zowe Project.
+ */
+
+
+/**
+ * Backend of user mapping library. It hides calls of z/OS services, so the JNI layer (javaUsermap.c) can be built with
+ * different implementations:
+ *  - usermapBackendZos.c - calls __certificate and R_usermap (zowe-common-c) on z/OS
+ *  - linux/usermapBackendSim.c - simulator with scripted answers for build hosts without z/OS
+ */
+
+#ifndef _Included_usermap_backend
+#define _Included_usermap_backend
+
+#ifdef __MVS__
+#include "zowe-common-c/h/rusermap.h"
+#endif
+
+/**
+ * Initialization of backend, it is called on loading of library. Returns 0 on success.
+ */
+int usermap_backend_init(void);
+
+/**
+ * Maps certificate to user ID (see __certificate with __CERTIFICATE_AUTHENTICATE). Both certificate and user ID are in
+ * EBCDIC. It returns the same values as __certificate (and sets errno).
+ */
+int usermap_backend_certificate(int certificateLength, char* certificate, int useridLength, char* userid);
+
+/**
+ * Maps distinguished name in registry to user ID (see getUseridByDN in zowe-common-c). All strings are in EBCDIC.
+ */
+int usermap_backend_dn(char* dn, int dnLength, char* registry, int registryLength, char* userid, int* returnCode,
+    int* reasonCode);
+
+/**
+ * Returns reason code (errno2) of the last failed call.
+ */
+int usermap_backend_errno2(void);
+
+#endif